@@ -0,0 +1,256 @@
+// Standard Library
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <utility>
+#include <algorithm>
+
+// Project headers
+#include "archive_writer.h"
+#include "jpeg_codec.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+    float elapsedMs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+    {
+        return std::chrono::duration<float, std::milli>(to - from).count();
+    }
+}
+
+// === Constructor ===
+ArchiveWriter::ArchiveWriter(size_t queue_capacity)
+    : capacity(queue_capacity),
+    running(false),
+    hold_count(0)
+{
+}
+
+// === Destructor ===
+ArchiveWriter::~ArchiveWriter()
+{
+    stop();
+}
+
+// === Starts the writer thread ===
+void ArchiveWriter::start()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running) return;
+
+    running = true;
+    thread.emplace(&ArchiveWriter::writeLoop, this);
+}
+
+// === Writes everything still queued, then stops the thread ===
+void ArchiveWriter::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running) return;
+
+        running = false;
+        hold_count = 0;
+    }
+
+    cv.notify_all();
+
+    if (thread && thread->joinable()) thread->join();
+    thread.reset();
+}
+
+// === Adds a hold ===
+void ArchiveWriter::hold()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ++hold_count;
+}
+
+// === Drops a hold ===
+void ArchiveWriter::release()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (hold_count == 0) return;
+        --hold_count;
+    }
+
+    cv.notify_all();
+}
+
+// === Queues encoded bytes ===
+bool ArchiveWriter::enqueue(const std::string& path, std::vector<unsigned char> data, ArchiveCallback done, ArchivePriority priority)
+{
+    WriteJob job;
+    job.path = path;
+    job.data = std::move(data);
+    job.done = std::move(done);
+    job.priority = priority;
+
+    return push(std::move(job));
+}
+
+// === Queues an image for encoding ===
+bool ArchiveWriter::enqueueImage(const std::string& path, const cv::Mat& image, ArchiveCallback done, ArchivePriority priority)
+{
+    WriteJob job;
+    job.path = path;
+    job.image = image;  // Shares the pixels; the caller hands the image over
+    job.done = std::move(done);
+    job.priority = priority;
+
+    return push(std::move(job));
+}
+
+// === Queues text ===
+bool ArchiveWriter::enqueueText(const std::string& path, const std::string& text, ArchiveCallback done, ArchivePriority priority)
+{
+    return enqueue(path, std::vector<unsigned char>(text.begin(), text.end()), std::move(done), priority);
+}
+
+// === Queues an ordered task ===
+bool ArchiveWriter::enqueueTask(std::function<void()> task)
+{
+    WriteJob job;
+    job.task = std::move(task);
+
+    return push(std::move(job));
+}
+
+// === Adds a job; a full queue drops diagnostics to make room ===
+bool ArchiveWriter::push(WriteJob&& job)
+{
+    job.enqueued = std::chrono::steady_clock::now();
+
+    bool inline_write = false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (!running)
+        {
+            inline_write = true;
+        }
+        else if (queue.size() >= capacity && job.priority == ArchivePriority::Diagnostic)
+        {
+            std::cerr << "[ARCHIVE ERROR] Queue full, dropped diagnostic: " << job.path << std::endl;
+            return false;
+        }
+        else
+        {
+            // Incident files are never dropped: evict a diagnostic job, or go beyond the capacity
+            if (queue.size() >= capacity)
+            {
+                auto diagnostic = std::find_if(queue.begin(), queue.end(), [](const WriteJob& queued) {
+                    return queued.priority == ArchivePriority::Diagnostic;
+                    });
+
+                if (diagnostic != queue.end())
+                {
+                    std::cerr << "[ARCHIVE ERROR] Queue full, dropped diagnostic: " << diagnostic->path << std::endl;
+                    queue.erase(diagnostic);
+                }
+                else
+                {
+                    std::cerr << "[ARCHIVE WARN] Queue over capacity (" << queue.size() + 1 << " jobs), keeping: "
+                        << (job.task ? "task" : job.path) << std::endl;
+                }
+            }
+
+            queue.push_back(std::move(job));
+        }
+    }
+
+    // Without a running thread, write in place rather than lose the file
+    if (inline_write)
+    {
+        if (job.task) job.task();
+        else write(job);
+
+        return true;
+    }
+
+    cv.notify_one();
+
+    return true;
+}
+
+// === Write loop executed in a separate thread ===
+void ArchiveWriter::writeLoop()
+{
+    while (true)
+    {
+        WriteJob job;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this] {
+                return (!queue.empty() && hold_count == 0) || !running;
+                });
+
+            if (queue.empty()) break;  // Stopped and drained
+
+            job = std::move(queue.front());
+            queue.pop_front();
+        }
+
+        if (job.task)
+        {
+            try
+            {
+                job.task();
+            }
+            catch (const std::exception& ex)
+            {
+                std::cerr << "[ARCHIVE ERROR] Task failed: " << ex.what() << std::endl;
+            }
+            continue;
+        }
+
+        write(job);
+    }
+}
+
+// === Encodes and writes one file through a temporary name ===
+void ArchiveWriter::write(WriteJob& job)
+{
+    ArchiveTiming timing;
+    timing.path = job.path;
+
+    const auto t_start = std::chrono::steady_clock::now();
+    timing.wait_ms = elapsedMs(job.enqueued, t_start);
+
+    const fs::path destination(job.path);
+    const fs::path temporary = destination.string() + ".part";
+
+    try
+    {
+        if (!job.image.empty())
+        {
+            if (!jpegCodec().encode(job.image, job.data)) throw std::runtime_error("JPEG encoding failed");
+            job.image.release();
+        }
+        const auto t_encoded = std::chrono::steady_clock::now();
+        timing.encode_ms = elapsedMs(t_start, t_encoded);
+
+        if (destination.has_parent_path()) fs::create_directories(destination.parent_path());
+
+        {
+            std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+            output.write(reinterpret_cast<const char*>(job.data.data()), static_cast<std::streamsize>(job.data.size()));
+            if (!output) throw std::runtime_error("write failed");
+        }
+
+        fs::rename(temporary, destination);
+        timing.write_ms = elapsedMs(t_encoded, std::chrono::steady_clock::now());
+        timing.ok = true;
+
+        std::cout << "[ARCHIVE] Saved: " << job.path << std::endl;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "[ARCHIVE ERROR] Failed to save " << job.path << ": " << ex.what() << std::endl;
+    }
+
+    if (job.done) job.done(timing);
+}
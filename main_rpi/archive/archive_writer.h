@@ -0,0 +1,177 @@
+#ifndef ARCHIVE_WRITER_H
+#define ARCHIVE_WRITER_H
+
+// Standard Library
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <optional>
+#include <functional>
+#include <condition_variable>
+
+// OpenCV
+#include <opencv2/opencv.hpp>
+
+// Project headers
+#include "config.h"
+
+/**
+ * @brief How long one archive write spent in each stage.
+ */
+struct ArchiveTiming
+{
+    std::string path;       ///< Destination path
+    float wait_ms = 0.0f;   ///< Time spent queued (including while held)
+    float encode_ms = 0.0f; ///< JPEG encoding (images only)
+    float write_ms = 0.0f;  ///< File write and rename
+    bool ok = false;        ///< Whether the file was written
+};
+
+/**
+ * @brief What a full queue may drop.
+ */
+enum class ArchivePriority
+{
+    Incident,   ///< Files of an incident (captures, results, logs): never dropped
+    Diagnostic  ///< Periodic diagnostics (trace dumps): dropped first
+};
+
+/**
+ * @brief Called on the writer thread when a write has finished.
+ */
+using ArchiveCallback = std::function<void(const ArchiveTiming&)>;
+
+/**
+ * @brief Encodes and writes archive files on a background thread.
+ *
+ * The queue is sized by ARCHIVE_QUEUE_CAPACITY for every open incident's
+ * files. When it is full, diagnostic jobs are dropped; an incident job evicts
+ * a queued diagnostic job or, failing that, is queued beyond the capacity,
+ * so incident files are never lost. While held, queued jobs wait so
+ * that disk and encoder work do not compete with an incident in progress.
+ * Holds are counted, so concurrent incidents each hold and release once.
+ */
+class ArchiveWriter
+{
+public:
+    /**
+     * @brief Constructs the writer (the thread starts with start()).
+     * @param Maximum number of queued jobs
+     */
+    explicit ArchiveWriter(size_t queue_capacity = ARCHIVE_QUEUE_CAPACITY);
+
+    /**
+     * @brief Flushes pending writes and stops the thread.
+     */
+    ~ArchiveWriter();
+
+    ArchiveWriter(const ArchiveWriter&) = delete;
+    ArchiveWriter& operator=(const ArchiveWriter&) = delete;
+
+    /**
+     * @brief Starts the writer thread.
+     */
+    void start();
+
+    /**
+     * @brief Releases all holds, writes everything still queued, then stops the thread.
+     */
+    void stop();
+
+    /**
+     * @brief Keeps queued jobs waiting until every hold() is matched by a release().
+     */
+    void hold();
+
+    /**
+     * @brief Drops one hold; queued jobs run again once none is left.
+     */
+    void release();
+
+    /**
+     * @brief Queues encoded bytes to be written to a file; parent directories are created.
+     * @param Destination path
+     * @param File contents
+     * @param Completion callback (may be empty)
+     * @param What a full queue may drop
+     * @return false if the job was dropped
+     */
+    bool enqueue(const std::string& path, std::vector<unsigned char> data, ArchiveCallback done = nullptr,
+        ArchivePriority priority = ArchivePriority::Incident);
+
+    /**
+     * @brief Queues an image to be JPEG-encoded and written on the writer thread.
+     * @param Destination path
+     * @param Image (not modified afterwards by the caller)
+     * @param Completion callback (may be empty)
+     * @param What a full queue may drop
+     * @return false if the job was dropped
+     */
+    bool enqueueImage(const std::string& path, const cv::Mat& image, ArchiveCallback done = nullptr,
+        ArchivePriority priority = ArchivePriority::Incident);
+
+    /**
+     * @brief Queues text (e.g. a JSON log) to be written to a file.
+     * @param Destination path
+     * @param File contents
+     * @param Completion callback (may be empty)
+     * @param What a full queue may drop
+     * @return false if the job was dropped
+     */
+    bool enqueueText(const std::string& path, const std::string& text, ArchiveCallback done = nullptr,
+        ArchivePriority priority = ArchivePriority::Incident);
+
+    /**
+     * @brief Queues a task that runs after every job queued before it (never dropped).
+     * @param Task
+     * @return Always true
+     */
+    bool enqueueTask(std::function<void()> task);
+
+private:
+    /**
+     * @brief A pending write, image encode or task.
+     */
+    struct WriteJob
+    {
+        std::string path;
+        std::vector<unsigned char> data;
+        cv::Mat image;
+        ArchiveCallback done;
+        std::function<void()> task;
+        ArchivePriority priority = ArchivePriority::Incident;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    /**
+     * @brief Adds a job; a full queue drops diagnostics to make room.
+     * @param Job
+     * @return false if dropped
+     */
+    bool push(WriteJob&& job);
+
+    /**
+     * @brief Write loop executed in a separate thread.
+     */
+    void writeLoop();
+
+    /**
+     * @brief Encodes (if needed) and writes one file through a temporary name.
+     * @param Job to write
+     */
+    void write(WriteJob& job);
+
+    // === Members ===
+    size_t capacity;
+
+    std::deque<WriteJob> queue;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::optional<std::thread> thread;
+    bool running;
+    size_t hold_count;
+};
+
+#endif // ARCHIVE_WRITER_H
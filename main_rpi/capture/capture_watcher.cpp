@@ -0,0 +1,312 @@
+// Standard Library
+#include <iostream>
+#include <utility>
+#include <algorithm>
+#include <cerrno>
+
+// System Library
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+// Project headers
+#include "capture_watcher.h"
+
+namespace {
+    constexpr size_t k_event_buffer_size = 1024 * (sizeof(struct inotify_event) + 16);
+    constexpr uint32_t k_watch_mask = IN_CLOSE_WRITE | IN_MOVED_TO;
+}
+
+// === Constructor ===
+CaptureWatcher::CaptureWatcher(const std::string& directory)
+    : directory(directory),
+    inotify_fd(-1),
+    watch_descriptor(-1),
+    epoll_fd(-1),
+    wake_fd(-1),
+    running(false)
+{
+}
+
+// === Destructor ===
+CaptureWatcher::~CaptureWatcher()
+{
+    stop();
+}
+
+// === Registers a handler for a filename rule ===
+void CaptureWatcher::addHandler(const std::string& rule, std::chrono::milliseconds deadline,
+    CaptureHandler on_capture, CaptureTimeoutHandler on_timeout, size_t max_pending)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Handler handler;
+    handler.rule = rule;
+    handler.deadline = deadline;
+    handler.on_capture = std::move(on_capture);
+    handler.on_timeout = std::move(on_timeout);
+    handler.max_pending = std::max<size_t>(max_pending, 1);
+
+    handlers.push_back(std::move(handler));
+}
+
+// === Opens the watch and starts the watcher thread ===
+bool CaptureWatcher::start()
+{
+    if (running) return true;
+
+    inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd < 0)
+    {
+        std::cerr << "[INOTIFY] Failed to initialize inotify." << std::endl;
+        cleanup();
+        return false;
+    }
+
+    watch_descriptor = inotify_add_watch(inotify_fd, directory.c_str(), k_watch_mask);
+    if (watch_descriptor < 0)
+    {
+        std::cerr << "[INOTIFY] Failed to add watch on directory: " << directory << std::endl;
+        cleanup();
+        return false;
+    }
+
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (wake_fd < 0 || epoll_fd < 0)
+    {
+        std::cerr << "[INOTIFY] Failed to create epoll / eventfd descriptors." << std::endl;
+        cleanup();
+        return false;
+    }
+
+    struct epoll_event inotify_event = {};
+    inotify_event.events = EPOLLIN;
+    inotify_event.data.fd = inotify_fd;
+
+    struct epoll_event wake_event = {};
+    wake_event.events = EPOLLIN;
+    wake_event.data.fd = wake_fd;
+
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, inotify_fd, &inotify_event) < 0 ||
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &wake_event) < 0)
+    {
+        std::cerr << "[INOTIFY] Failed to register descriptors with epoll." << std::endl;
+        cleanup();
+        return false;
+    }
+
+    running = true;
+    thread.emplace(&CaptureWatcher::watchLoop, this);
+
+    std::cout << "[INOTIFY] Watching " << directory << " for completed captures" << std::endl;
+
+    return true;
+}
+
+// === Signals the watcher thread to stop and waits for it ===
+void CaptureWatcher::stop()
+{
+    if (!running)
+    {
+        cleanup();
+        return;
+    }
+
+    running = false;
+    wake();
+
+    if (thread && thread->joinable()) thread->join();
+
+    thread.reset();
+    cleanup();
+}
+
+// === Expects one more capture with its own deadline ===
+bool CaptureWatcher::arm(const std::string& rule, uint64_t token)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto it = std::find_if(handlers.begin(), handlers.end(), [&rule](const Handler& h) {
+            return h.rule == rule;
+            });
+        if (it == handlers.end()) return false;
+
+        // The deadline is the same for every arm of a rule, so the queue stays ordered by expiry
+        if (it->pending.size() >= it->max_pending) it->pending.pop_front();
+        it->pending.push_back({ std::chrono::steady_clock::now() + it->deadline, token });
+    }
+
+    wake();
+
+    return true;
+}
+
+// === Expects one capture fewer ===
+void CaptureWatcher::disarm(const std::string& rule, uint64_t token)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto& handler : handlers)
+    {
+        if (handler.rule != rule || handler.pending.empty()) continue;
+
+        // Captures are claimed oldest first, so another arm's capture may have taken this token's entry
+        auto it = std::find_if(handler.pending.begin(), handler.pending.end(), [token](const PendingCapture& capture) {
+            return capture.token == token;
+            });
+        handler.pending.erase(it != handler.pending.end() ? it : handler.pending.begin());
+    }
+}
+
+// === epoll loop executed in a separate thread ===
+void CaptureWatcher::watchLoop()
+{
+    struct epoll_event events[2];
+
+    while (running)
+    {
+        const int timeout_ms = expireHandlers();
+        const int ready = epoll_wait(epoll_fd, events, 2, timeout_ms);
+
+        if (ready < 0)
+        {
+            if (errno == EINTR) continue;
+
+            std::cerr << "[INOTIFY] epoll_wait failed; capture watcher stopped." << std::endl;
+            break;
+        }
+
+        for (int i = 0; i < ready; ++i)
+        {
+            if (events[i].data.fd == wake_fd)
+            {
+                uint64_t value;
+                while (read(wake_fd, &value, sizeof(value)) > 0) {}
+            }
+            else if (events[i].data.fd == inotify_fd)
+            {
+                readEvents();
+            }
+        }
+    }
+}
+
+// === Drains inotify events and dispatches matching files ===
+void CaptureWatcher::readEvents()
+{
+    alignas(struct inotify_event) char buffer[k_event_buffer_size];
+
+    while (true)
+    {
+        const ssize_t length = read(inotify_fd, buffer, sizeof(buffer));
+        if (length <= 0) break;
+
+        for (ssize_t i = 0; i < length;)
+        {
+            const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(&buffer[i]);
+            i += sizeof(struct inotify_event) + event->len;
+
+            if (!(event->mask & k_watch_mask) || event->len == 0) continue;
+
+            CaptureFrame frame;
+            frame.name = event->name;
+
+            CaptureHandler on_capture = claim(frame.name);
+            if (!on_capture) continue;
+
+            frame.path = directory + "/" + frame.name;
+            on_capture(std::move(frame));
+        }
+    }
+}
+
+// === Dispatches a frame received in memory ===
+bool CaptureWatcher::deliver(CaptureFrame&& frame)
+{
+    CaptureHandler on_capture = claim(frame.name);
+    if (!on_capture) return false;
+
+    on_capture(std::move(frame));
+
+    return true;
+}
+
+// === Takes one pending capture of the first armed rule matching a file name ===
+CaptureHandler CaptureWatcher::claim(const std::string& filename)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto& handler : handlers)
+    {
+        if (handler.pending.empty() || filename.find(handler.rule) == std::string::npos) continue;
+
+        handler.pending.pop_front();
+        return handler.on_capture;
+    }
+
+    return nullptr;
+}
+
+// === Fires expired deadlines and returns the time to the next one ===
+int CaptureWatcher::expireHandlers()
+{
+    std::vector<CaptureTimeoutHandler> expired;
+    int timeout_ms = -1;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto now = std::chrono::steady_clock::now();
+
+        for (auto& handler : handlers)
+        {
+            // Each expected capture times out on its own
+            while (!handler.pending.empty() && handler.pending.front().expires <= now)
+            {
+                handler.pending.pop_front();
+                if (handler.on_timeout) expired.push_back(handler.on_timeout);
+            }
+            if (handler.pending.empty()) continue;
+
+            // Round up so the next wake-up is never before the deadline
+            const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(handler.pending.front().expires - now).count();
+            const int remaining_ms = static_cast<int>(remaining);
+            if (timeout_ms < 0 || remaining_ms < timeout_ms) timeout_ms = remaining_ms;
+        }
+    }
+
+    for (const auto& on_timeout : expired) on_timeout();
+
+    return timeout_ms;
+}
+
+// === Wakes the watcher thread ===
+void CaptureWatcher::wake()
+{
+    if (wake_fd < 0) return;
+
+    const uint64_t one = 1;
+    if (write(wake_fd, &one, sizeof(one)) < 0)
+    {
+        // Counter saturated: the thread is already due to wake up
+    }
+}
+
+// === Closes all descriptors ===
+void CaptureWatcher::cleanup()
+{
+    if (inotify_fd >= 0)
+    {
+        if (watch_descriptor >= 0) inotify_rm_watch(inotify_fd, watch_descriptor);
+        close(inotify_fd);
+    }
+    if (epoll_fd >= 0) close(epoll_fd);
+    if (wake_fd >= 0) close(wake_fd);
+
+    inotify_fd = -1;
+    watch_descriptor = -1;
+    epoll_fd = -1;
+    wake_fd = -1;
+}
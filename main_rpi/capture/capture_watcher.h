@@ -0,0 +1,179 @@
+#ifndef CAPTURE_WATCHER_H
+#define CAPTURE_WATCHER_H
+
+// Standard Library
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <optional>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief A completed capture, either a file on disk or an encoded image in memory.
+ */
+struct CaptureFrame
+{
+    std::string name;                   ///< File name as uploaded by the camera
+    std::string path;                   ///< Full path on disk (empty for in-memory frames)
+    std::vector<unsigned char> data;    ///< Encoded image (empty for files on disk)
+};
+
+/**
+ * @brief Called with a completed capture.
+ */
+using CaptureHandler = std::function<void(CaptureFrame)>;
+
+/**
+ * @brief Called when an armed handler sees no capture before its deadline.
+ */
+using CaptureTimeoutHandler = std::function<void()>;
+
+/**
+ * @brief Watches one capture directory and dispatches finished files by filename rule.
+ *
+ * A single thread waits on an inotify descriptor through epoll and reacts to
+ * IN_CLOSE_WRITE / IN_MOVED_TO, so files are only seen once the uploader has
+ * finished writing them. Each handler is matched by a substring of the file
+ * name and fires once per pending arm(); each arm() has its own deadline. Frames pushed
+ * from memory (see FtpIngestServer) go through the same
+ * rules via deliver().
+ */
+class CaptureWatcher
+{
+public:
+    /**
+     * @brief Constructs the watcher for a directory (nothing is opened yet).
+     * @param Directory to watch
+     */
+    explicit CaptureWatcher(const std::string& directory);
+
+    /**
+     * @brief Stops the watcher thread and closes its descriptors.
+     */
+    ~CaptureWatcher();
+
+    CaptureWatcher(const CaptureWatcher&) = delete;
+    CaptureWatcher& operator=(const CaptureWatcher&) = delete;
+
+    /**
+     * @brief Registers a handler for file names containing a rule string.
+     * @param Rule string (e.g. "EventRule_1-CH1")
+     * @param Time allowed between arm() and the capture
+     * @param Capture handler, run on the watcher thread
+     * @param Timeout handler, run on the watcher thread (may be empty)
+     * @param Captures that may be expected at once
+     */
+    void addHandler(const std::string& rule, std::chrono::milliseconds deadline,
+        CaptureHandler on_capture, CaptureTimeoutHandler on_timeout = nullptr, size_t max_pending = 1);
+
+    /**
+     * @brief Opens the inotify watch and starts the watcher thread.
+     * @return true if successful, false otherwise.
+     */
+    bool start();
+
+    /**
+     * @brief Signals the watcher thread to stop and waits for it.
+     */
+    void stop();
+
+    /**
+     * @brief Expects one more capture for a rule, with its own deadline.
+     * @param Rule string passed to addHandler()
+     * @param Token identifying this arm for disarm() (e.g. the incident id)
+     * @return false if no handler is registered for the rule
+     *
+     * At max_pending, the oldest pending capture is dropped for this one.
+     */
+    bool arm(const std::string& rule, uint64_t token = 0);
+
+    /**
+     * @brief Expects one capture fewer for a rule.
+     * @param Rule string passed to addHandler()
+     * @param Token given to arm(); if no pending capture has it, the oldest one is dropped
+     */
+    void disarm(const std::string& rule, uint64_t token = 0);
+
+    /**
+     * @brief Dispatches a frame received in memory, on the caller's thread.
+     * @param Frame with name and encoded data; moved from only if a rule takes it
+     * @return false if no armed rule matches the frame name
+     */
+    bool deliver(CaptureFrame&& frame);
+
+private:
+    /**
+     * @brief One expected capture of a rule.
+     */
+    struct PendingCapture
+    {
+        std::chrono::steady_clock::time_point expires;
+        uint64_t token = 0;
+    };
+
+    /**
+     * @brief A registered rule with its arming state.
+     */
+    struct Handler
+    {
+        std::string rule;
+        std::chrono::milliseconds deadline;
+        CaptureHandler on_capture;
+        CaptureTimeoutHandler on_timeout;
+        size_t max_pending = 1;
+        std::deque<PendingCapture> pending;  ///< Captures expected, oldest first; armed while non-empty
+    };
+
+    /**
+     * @brief epoll loop executed in a separate thread.
+     */
+    void watchLoop();
+
+    /**
+     * @brief Drains pending inotify events and dispatches matching files.
+     */
+    void readEvents();
+
+    /**
+     * @brief Takes one pending capture of the first armed rule matching a file name.
+     * @param File name
+     * @return Capture handler, or empty if none matches
+     */
+    CaptureHandler claim(const std::string& filename);
+
+    /**
+     * @brief Fires timeout handlers whose deadline has passed.
+     * @return Milliseconds until the next deadline, or -1 if none is armed
+     */
+    int expireHandlers();
+
+    /**
+     * @brief Wakes the watcher thread so it re-reads deadlines.
+     */
+    void wake();
+
+    /**
+     * @brief Closes all descriptors.
+     */
+    void cleanup();
+
+    // === Members ===
+    std::string directory;
+    std::vector<Handler> handlers;
+    std::mutex mutex;
+
+    int inotify_fd;
+    int watch_descriptor;
+    int epoll_fd;
+    int wake_fd;
+
+    std::optional<std::thread> thread;
+    std::atomic<bool> running;
+};
+
+#endif // CAPTURE_WATCHER_H
@@ -0,0 +1,95 @@
+#ifndef CLIENT_THREADS_H
+#define CLIENT_THREADS_H
+
+// Standard Library
+#include <list>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <functional>
+
+/**
+ * @brief Threads serving the connections of one server, one per client.
+ *
+ * The accept loop starts a thread per connection and reaps the finished ones
+ * before each accept, so an idle client never blocks the others. Not
+ * thread-safe: only the accept loop (and stop, after it has exited) touch it.
+ */
+class ClientThreads
+{
+public:
+    explicit ClientThreads(size_t max_clients)
+        : max_clients(max_clients)
+    {
+    }
+
+    ~ClientThreads()
+    {
+        joinAll();
+    }
+
+    ClientThreads(const ClientThreads&) = delete;
+    ClientThreads& operator=(const ClientThreads&) = delete;
+
+    /**
+     * @brief Runs a client on its own thread.
+     * @param Function serving the client until it disconnects
+     * @return false if max_clients are already being served (the caller closes the connection)
+     */
+    bool start(std::function<void()> serve)
+    {
+        reap();
+        if (clients.size() >= max_clients) return false;
+
+        auto finished = std::make_shared<std::atomic<bool>>(false);
+        clients.push_back({ std::thread([serve = std::move(serve), finished]()
+            {
+                serve();
+                *finished = true;
+            }), finished });
+
+        return true;
+    }
+
+    /**
+     * @brief Joins the threads whose client has finished.
+     */
+    void reap()
+    {
+        for (auto it = clients.begin(); it != clients.end();)
+        {
+            if (!*it->finished)
+            {
+                ++it;
+                continue;
+            }
+
+            it->thread.join();
+            it = clients.erase(it);
+        }
+    }
+
+    /**
+     * @brief Joins every thread; the server must already have woken them up.
+     */
+    void joinAll()
+    {
+        for (auto& client : clients)
+        {
+            if (client.thread.joinable()) client.thread.join();
+        }
+        clients.clear();
+    }
+
+private:
+    struct Client
+    {
+        std::thread thread;
+        std::shared_ptr<std::atomic<bool>> finished;
+    };
+
+    size_t max_clients;
+    std::list<Client> clients;
+};
+
+#endif // CLIENT_THREADS_H
@@ -0,0 +1,491 @@
+// Standard Library
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include <cctype>
+#include <algorithm>
+
+// System Library
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/eventfd.h>
+#include <arpa/inet.h>
+
+// Project headers
+#include "ftp_ingest_server.h"
+#include "config.h"
+
+namespace {
+    constexpr size_t k_max_line_length = 1024;
+    constexpr size_t k_max_file_size = 16 * 1024 * 1024;
+    constexpr size_t k_recv_chunk_size = 64 * 1024;
+    constexpr int k_data_timeout_ms = 10000;
+
+    // Bare file name of an FTP path; empty for names that must not be written
+    std::string fileName(const std::string& path)
+    {
+        const std::string name = path.substr(path.find_last_of('/') + 1);
+        if (name.empty() || name[0] == '.') return std::string();
+
+        return name;
+    }
+}
+
+// === Constructor ===
+FtpIngestServer::FtpIngestServer(uint16_t port, const std::string& directory, const std::string& user, const std::string& password, CaptureWatcher& capture_watcher)
+    : port(port),
+    directory(directory),
+    user(user),
+    password(password),
+    capture_watcher(capture_watcher),
+    server_fd(-1),
+    wake_fd(-1),
+    sessions(INGEST_MAX_CLIENTS),
+    running(false),
+    temp_counter(0)
+{
+}
+
+// === Destructor ===
+FtpIngestServer::~FtpIngestServer()
+{
+    stop();
+}
+
+// === Binds the port and starts the server thread ===
+bool FtpIngestServer::start()
+{
+    if (running) return true;
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+
+    const int reuse = 1;
+
+    server_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (server_fd < 0 || wake_fd < 0 ||
+        setsockopt(server_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0 ||
+        bind(server_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(server_fd, SOMAXCONN) < 0)
+    {
+        std::cerr << "[FTP] Failed to listen on port " << port << std::endl;
+        cleanup();
+        return false;
+    }
+
+    running = true;
+    thread.emplace(&FtpIngestServer::serveLoop, this);
+
+    std::cout << "[FTP] Receiving camera uploads on port " << port << std::endl;
+
+    return true;
+}
+
+// === Signals the server thread to stop and waits for it ===
+void FtpIngestServer::stop()
+{
+    if (running)
+    {
+        running = false;
+
+        const uint64_t one = 1;
+        if (write(wake_fd, &one, sizeof(one)) < 0)
+        {
+            // Counter saturated: the threads are already due to wake up
+        }
+
+        if (thread && thread->joinable()) thread->join();
+        thread.reset();
+    }
+
+    cleanup();
+}
+
+// === Accept loop executed in a separate thread ===
+void FtpIngestServer::serveLoop()
+{
+    while (running)
+    {
+        pollfd fds[2] = { { server_fd, POLLIN, 0 }, { wake_fd, POLLIN, 0 } };
+
+        int ret = poll(fds, 2, -1);
+        if (ret < 0 && errno != EINTR) break;
+        if (ret <= 0 || !(fds[0].revents & POLLIN)) continue;
+
+        int control_fd = accept4(server_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (control_fd < 0) continue;
+
+        const bool started = sessions.start([this, control_fd]()
+            {
+                serveSession(control_fd);
+                close(control_fd);
+            });
+        if (!started)
+        {
+            const char busy[] = "421 Too many connections\r\n";
+            if (send(control_fd, busy, sizeof(busy) - 1, MSG_NOSIGNAL) < 0)
+            {
+                // Closing anyway
+            }
+            close(control_fd);
+        }
+    }
+
+    // The wake eventfd stays readable, so every session returns
+    sessions.joinAll();
+}
+
+// === Runs one session ===
+void FtpIngestServer::serveSession(int control_fd)
+{
+    Session session;
+    session.control_fd = control_fd;
+
+    if (reply(session, "220 Capture ingest ready"))
+    {
+        std::string line;
+        while (running && readLine(session, line))
+        {
+            const size_t space = line.find(' ');
+            std::string verb = line.substr(0, space);
+            const std::string argument = (space == std::string::npos) ? std::string() : line.substr(space + 1);
+            std::transform(verb.begin(), verb.end(), verb.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+
+            if (!handleCommand(session, verb, argument)) break;
+        }
+    }
+
+    if (session.passive_fd >= 0) close(session.passive_fd);
+}
+
+// === Executes one command ===
+bool FtpIngestServer::handleCommand(Session& session, const std::string& verb, const std::string& argument)
+{
+    if (verb == "USER")
+    {
+        session.user = argument;
+        session.logged_in = false;
+        return reply(session, "331 Password required");
+    }
+    if (verb == "PASS")
+    {
+        session.logged_in = (session.user == user && argument == password);
+        if (!session.logged_in) std::cerr << "[FTP] Login failed for user '" << session.user << "'" << std::endl;
+        return reply(session, session.logged_in ? "230 Logged in" : "530 Login incorrect");
+    }
+    if (verb == "QUIT")
+    {
+        reply(session, "221 Bye");
+        return false;
+    }
+    if (verb == "SYST") return reply(session, "215 UNIX Type: L8");
+    if (verb == "FEAT") return reply(session, "211 No features");
+    if (verb == "NOOP") return reply(session, "200 OK");
+
+    if (!session.logged_in) return reply(session, "530 Please login with USER and PASS");
+
+    if (verb == "TYPE" || verb == "MODE" || verb == "STRU" || verb == "OPTS" || verb == "ALLO") return reply(session, "200 OK");
+    if (verb == "PWD" || verb == "XPWD") return reply(session, "257 \"/\" is the current directory");
+    if (verb == "CWD" || verb == "XCWD" || verb == "CDUP") return reply(session, "250 Directory changed");
+    if (verb == "MKD" || verb == "XMKD") return reply(session, "257 \"" + argument + "\" created");
+
+    if (verb == "PASV" || verb == "EPSV")
+    {
+        const uint16_t data_port = openPassive(session);
+        if (data_port == 0) return reply(session, "425 Cannot open passive connection");
+
+        if (verb == "EPSV") return reply(session, "229 Entering Extended Passive Mode (|||" + std::to_string(data_port) + "|)");
+
+        sockaddr_in local{};
+        socklen_t length = sizeof(local);
+        getsockname(session.control_fd, reinterpret_cast<sockaddr*>(&local), &length);
+        const uint32_t host = ntohl(local.sin_addr.s_addr);
+
+        return reply(session, "227 Entering Passive Mode (" +
+            std::to_string((host >> 24) & 0xFF) + "," + std::to_string((host >> 16) & 0xFF) + "," +
+            std::to_string((host >> 8) & 0xFF) + "," + std::to_string(host & 0xFF) + "," +
+            std::to_string(data_port >> 8) + "," + std::to_string(data_port & 0xFF) + ")");
+    }
+    if (verb == "PORT")
+    {
+        unsigned int h1, h2, h3, h4, p1, p2;
+        if (std::sscanf(argument.c_str(), "%u,%u,%u,%u,%u,%u", &h1, &h2, &h3, &h4, &p1, &p2) != 6 ||
+            h1 > 255 || h2 > 255 || h3 > 255 || h4 > 255 || p1 > 255 || p2 > 255)
+        {
+            return reply(session, "501 Syntax error in PORT");
+        }
+
+        // Data connections only go back to the client itself
+        sockaddr_in peer{};
+        socklen_t length = sizeof(peer);
+        getpeername(session.control_fd, reinterpret_cast<sockaddr*>(&peer), &length);
+        if (ntohl(peer.sin_addr.s_addr) != ((h1 << 24) | (h2 << 16) | (h3 << 8) | h4)) return reply(session, "504 PORT must name the client");
+
+        if (session.passive_fd >= 0)
+        {
+            close(session.passive_fd);
+            session.passive_fd = -1;
+        }
+        session.active = true;
+        session.active_address = peer;
+        session.active_address.sin_port = htons(static_cast<uint16_t>((p1 << 8) | p2));
+
+        return reply(session, "200 PORT command successful");
+    }
+
+    if (verb == "STOR")
+    {
+        const std::string name = fileName(argument);
+        if (name.empty()) return reply(session, "553 File name not allowed");
+
+        return receiveFile(session, name);
+    }
+    if (verb == "DELE")
+    {
+        const std::string name = fileName(argument);
+        const bool removed = !name.empty() && std::remove((directory + "/" + name).c_str()) == 0;
+        return reply(session, removed ? "250 File deleted" : "550 No such file");
+    }
+    if (verb == "RNFR")
+    {
+        session.rename_from = fileName(argument);
+        const bool exists = !session.rename_from.empty() && access((directory + "/" + session.rename_from).c_str(), F_OK) == 0;
+        if (!exists) session.rename_from.clear();
+        return reply(session, exists ? "350 Ready for RNTO" : "550 No such file");
+    }
+    if (verb == "RNTO")
+    {
+        // The watcher sees the renamed file (IN_MOVED_TO) like any other upload
+        const std::string name = fileName(argument);
+        const bool renamed = !session.rename_from.empty() && !name.empty() &&
+            std::rename((directory + "/" + session.rename_from).c_str(), (directory + "/" + name).c_str()) == 0;
+        session.rename_from.clear();
+        return reply(session, renamed ? "250 File renamed" : "550 Rename failed");
+    }
+
+    return reply(session, "502 Command not implemented");
+}
+
+// === Receives a STOR ===
+bool FtpIngestServer::receiveFile(Session& session, const std::string& name)
+{
+    const int data_fd = connectData(session);
+    if (data_fd < 0) return reply(session, "425 Cannot open data connection");
+
+    if (!reply(session, "150 Opening BINARY mode data connection"))
+    {
+        close(data_fd);
+        return false;
+    }
+
+    CaptureFrame frame;
+    frame.name = name;
+
+    bool complete = false;
+    while (waitReadable(data_fd, k_data_timeout_ms))
+    {
+        const size_t used = frame.data.size();
+        if (used >= k_max_file_size) break;
+
+        frame.data.resize(std::min(used + k_recv_chunk_size, k_max_file_size + 1));
+        const ssize_t received = recv(data_fd, frame.data.data() + used, frame.data.size() - used, 0);
+        frame.data.resize(used + std::max<ssize_t>(received, 0));
+
+        if (received == 0)
+        {
+            complete = true;
+            break;
+        }
+        if (received < 0 && errno != EINTR) break;
+    }
+    close(data_fd);
+
+    if (!complete)
+    {
+        std::cerr << "[FTP] Upload of " << name << " aborted." << std::endl;
+        return reply(session, "426 Transfer aborted");
+    }
+
+    // An armed rule takes the frame from memory; anything else lands in the directory as before
+    if (capture_watcher.deliver(std::move(frame))) return reply(session, "226 Transfer complete");
+    if (storeToDisk(name, frame.data)) return reply(session, "226 Transfer complete");
+
+    std::cerr << "[FTP] Failed to write " << name << std::endl;
+    return reply(session, "451 Local error in processing");
+}
+
+// === Opens a listening data socket ===
+uint16_t FtpIngestServer::openPassive(Session& session)
+{
+    if (session.passive_fd >= 0) close(session.passive_fd);
+    session.active = false;
+
+    sockaddr_in addr{};
+    socklen_t length = sizeof(addr);
+    getsockname(session.control_fd, reinterpret_cast<sockaddr*>(&addr), &length);
+    addr.sin_port = 0;
+
+    session.passive_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (session.passive_fd < 0 ||
+        bind(session.passive_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(session.passive_fd, 1) < 0 ||
+        getsockname(session.passive_fd, reinterpret_cast<sockaddr*>(&addr), &length) < 0)
+    {
+        if (session.passive_fd >= 0) close(session.passive_fd);
+        session.passive_fd = -1;
+        return 0;
+    }
+
+    return ntohs(addr.sin_port);
+}
+
+// === Connects the data channel ===
+int FtpIngestServer::connectData(Session& session)
+{
+    int data_fd = -1;
+
+    if (session.passive_fd >= 0)
+    {
+        sockaddr_storage data_peer{};
+        socklen_t data_length = sizeof(data_peer);
+        if (waitReadable(session.passive_fd, k_data_timeout_ms))
+        {
+            data_fd = accept4(session.passive_fd, reinterpret_cast<sockaddr*>(&data_peer), &data_length, SOCK_CLOEXEC);
+        }
+
+        // Like PORT, the data connection must come from the client itself, or anyone could take over the STOR
+        sockaddr_storage control_peer{};
+        socklen_t control_length = sizeof(control_peer);
+        if (data_fd >= 0 &&
+            (getpeername(session.control_fd, reinterpret_cast<sockaddr*>(&control_peer), &control_length) < 0 ||
+             data_peer.ss_family != AF_INET || control_peer.ss_family != AF_INET ||
+             reinterpret_cast<const sockaddr_in&>(data_peer).sin_addr.s_addr != reinterpret_cast<const sockaddr_in&>(control_peer).sin_addr.s_addr))
+        {
+            std::cerr << "[FTP] Refused a passive data connection from another host." << std::endl;
+            close(data_fd);
+            data_fd = -1;
+        }
+
+        close(session.passive_fd);
+        session.passive_fd = -1;
+    }
+    else if (session.active)
+    {
+        data_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (data_fd >= 0 && connect(data_fd, reinterpret_cast<sockaddr*>(&session.active_address), sizeof(session.active_address)) < 0)
+        {
+            close(data_fd);
+            data_fd = -1;
+        }
+
+        session.active = false;
+    }
+
+    return data_fd;
+}
+
+// === Writes a file no rule took ===
+bool FtpIngestServer::storeToDisk(const std::string& name, const std::vector<unsigned char>& data)
+{
+    // A dot name matches no rule, so the watcher only sees the file once it is renamed
+    const std::string temp_path = directory + "/.ftp_ingest_" + std::to_string(temp_counter++) + ".part";
+
+    {
+        std::ofstream output(temp_path, std::ios::binary);
+        output.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!output)
+        {
+            output.close();
+            std::remove(temp_path.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(temp_path.c_str(), (directory + "/" + name).c_str()) != 0)
+    {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+// === Reads one line from the control connection ===
+bool FtpIngestServer::readLine(Session& session, std::string& line)
+{
+    while (true)
+    {
+        const size_t end = session.buffer.find('\n');
+        if (end != std::string::npos)
+        {
+            line = session.buffer.substr(0, end);
+            session.buffer.erase(0, end + 1);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            return true;
+        }
+
+        if (session.buffer.size() > k_max_line_length) return false;
+        if (!waitReadable(session.control_fd, INGEST_IDLE_TIMEOUT_MS)) return false;
+
+        char chunk[512];
+        const ssize_t received = recv(session.control_fd, chunk, sizeof(chunk), 0);
+        if (received <= 0) return false;
+
+        session.buffer.append(chunk, static_cast<size_t>(received));
+    }
+}
+
+// === Sends one reply line ===
+bool FtpIngestServer::reply(const Session& session, const std::string& text)
+{
+    const std::string line = text + "\r\n";
+    size_t sent = 0;
+
+    while (sent < line.size())
+    {
+        const ssize_t ret = send(session.control_fd, line.data() + sent, line.size() - sent, MSG_NOSIGNAL);
+        if (ret <= 0) return false;
+
+        sent += static_cast<size_t>(ret);
+    }
+
+    return true;
+}
+
+// === Waits until a descriptor is readable ===
+bool FtpIngestServer::waitReadable(int fd, int timeout_ms)
+{
+    while (running)
+    {
+        pollfd fds[2] = { { fd, POLLIN, 0 }, { wake_fd, POLLIN, 0 } };
+
+        const int ret = poll(fds, 2, timeout_ms);
+        if (ret < 0 && errno == EINTR) continue;
+
+        return ret > 0 && running && (fds[0].revents & (POLLIN | POLLHUP));
+    }
+
+    return false;
+}
+
+// === Closes all descriptors ===
+void FtpIngestServer::cleanup()
+{
+    if (server_fd >= 0)
+    {
+        close(server_fd);
+        server_fd = -1;
+    }
+
+    if (wake_fd >= 0)
+    {
+        close(wake_fd);
+        wake_fd = -1;
+    }
+}
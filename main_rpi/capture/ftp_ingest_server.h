@@ -0,0 +1,161 @@
+#ifndef FTP_INGEST_SERVER_H
+#define FTP_INGEST_SERVER_H
+
+// Standard Library
+#include <string>
+#include <vector>
+#include <thread>
+#include <optional>
+#include <atomic>
+#include <cstdint>
+
+// System Library
+#include <netinet/in.h>
+
+// Project headers
+#include "capture_watcher.h"
+#include "client_threads.h"
+
+/**
+ * @brief Minimal FTP server that the cameras upload their captures to.
+ *
+ * The network cameras can only push event captures over FTP. This server
+ * takes the place of the system FTP daemon for the capture directory: an
+ * upload is received into memory and offered to the watcher's rules through
+ * deliver(), so the capture never touches the disk. A file no armed rule
+ * takes is written into the directory as the daemon would have written it
+ * (under a temporary name, then renamed), so nothing else changes.
+ *
+ * One login, binary STOR, passive (PASV/EPSV) and active (PORT, back to the
+ * client's own address only) transfers, and RNFR/RNTO/DELE on written files.
+ * Directories are accepted and flattened. Each session runs on its own thread.
+ */
+class FtpIngestServer
+{
+public:
+    /**
+     * @brief Constructs the server (nothing is opened yet).
+     * @param TCP port to listen on
+     * @param Capture directory for files no rule takes
+     * @param User name the camera logs in with
+     * @param Password the camera logs in with
+     * @param Watcher whose rules dispatch received files
+     */
+    FtpIngestServer(uint16_t port, const std::string& directory, const std::string& user, const std::string& password, CaptureWatcher& capture_watcher);
+
+    /**
+     * @brief Stops the server thread and all sessions.
+     */
+    ~FtpIngestServer();
+
+    FtpIngestServer(const FtpIngestServer&) = delete;
+    FtpIngestServer& operator=(const FtpIngestServer&) = delete;
+
+    /**
+     * @brief Binds the port and starts the server thread.
+     * @return true if successful, false otherwise.
+     */
+    bool start();
+
+    /**
+     * @brief Signals the server thread and the sessions to stop and waits for them.
+     */
+    void stop();
+
+private:
+    /**
+     * @brief State of one control connection.
+     */
+    struct Session
+    {
+        int control_fd = -1;
+        std::string buffer;             ///< Received control bytes not yet split into lines
+        std::string user;
+        bool logged_in = false;
+        int passive_fd = -1;            ///< Listening data socket after PASV/EPSV
+        bool active = false;            ///< PORT given; active_address is set
+        sockaddr_in active_address{};
+        std::string rename_from;
+    };
+
+    /**
+     * @brief Accept loop executed in a separate thread.
+     */
+    void serveLoop();
+
+    /**
+     * @brief Runs one session until QUIT, disconnect, idle timeout or shutdown.
+     * @param Control connection file descriptor
+     */
+    void serveSession(int control_fd);
+
+    /**
+     * @brief Executes one command.
+     * @return false if the session should end.
+     */
+    bool handleCommand(Session& session, const std::string& verb, const std::string& argument);
+
+    /**
+     * @brief Receives a STOR into memory and hands it to the rules or the directory.
+     * @return false if the control connection failed.
+     */
+    bool receiveFile(Session& session, const std::string& name);
+
+    /**
+     * @brief Opens a listening data socket on the control connection's address.
+     * @return Port number, or 0 on failure.
+     */
+    uint16_t openPassive(Session& session);
+
+    /**
+     * @brief Connects the data channel prepared by PASV/EPSV or PORT.
+     * @return Data socket, or -1 on failure.
+     */
+    int connectData(Session& session);
+
+    /**
+     * @brief Writes a file no rule took into the capture directory.
+     * @return true if the file was written.
+     */
+    bool storeToDisk(const std::string& name, const std::vector<unsigned char>& data);
+
+    /**
+     * @brief Reads one CRLF-terminated line from the control connection.
+     * @return false on disconnect, idle timeout, oversized line or shutdown.
+     */
+    bool readLine(Session& session, std::string& line);
+
+    /**
+     * @brief Sends one reply line (CRLF is appended).
+     * @return false if the connection failed.
+     */
+    bool reply(const Session& session, const std::string& text);
+
+    /**
+     * @brief Waits until a descriptor is readable.
+     * @return false on timeout or shutdown.
+     */
+    bool waitReadable(int fd, int timeout_ms);
+
+    /**
+     * @brief Closes all descriptors.
+     */
+    void cleanup();
+
+    // === Members ===
+    uint16_t port;
+    std::string directory;
+    std::string user;
+    std::string password;
+    CaptureWatcher& capture_watcher;
+
+    int server_fd;
+    int wake_fd;
+
+    std::optional<std::thread> thread;
+    ClientThreads sessions;
+    std::atomic<bool> running;
+    std::atomic<uint64_t> temp_counter;
+};
+
+#endif // FTP_INGEST_SERVER_H
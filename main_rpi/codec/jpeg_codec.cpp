@@ -0,0 +1,186 @@
+// Standard Library
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+
+// TurboJPEG
+#if defined(HAVE_TURBOJPEG)
+#include <turbojpeg.h>
+#endif
+
+// Project headers
+#include "jpeg_codec.h"
+
+namespace {
+    bool isValidScale(int scale_denom) {
+        return scale_denom == 1 || scale_denom == 2 || scale_denom == 4 || scale_denom == 8;
+    }
+
+#if defined(HAVE_TURBOJPEG)
+    // TurboJPEG handles are not thread-safe; each thread keeps its own pair
+    struct TurboHandles {
+        tjhandle decompressor = tjInitDecompress();
+        tjhandle compressor = tjInitCompress();
+
+        ~TurboHandles() {
+            if (decompressor) tjDestroy(decompressor);
+            if (compressor) tjDestroy(compressor);
+        }
+    };
+
+    TurboHandles& turboHandles() {
+        thread_local TurboHandles handles;
+        return handles;
+    }
+#endif
+}
+
+// === Reads and decodes a JPEG file ===
+cv::Mat JpegCodec::decodeFile(const std::string& path, int scale_denom) const {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) return cv::Mat();
+
+    const std::vector<unsigned char> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+    return decode(data.data(), data.size(), scale_denom);
+}
+
+// === OpenCV Decode ===
+cv::Mat OpenCvJpegCodec::decode(const unsigned char* data, size_t size, int scale_denom) const {
+    if (!data || size == 0 || !isValidScale(scale_denom)) return cv::Mat();
+
+    // The IMREAD_REDUCED_* flags map to libjpeg's DCT scaling
+    int flags = cv::IMREAD_COLOR;
+    if (scale_denom == 2) flags = cv::IMREAD_REDUCED_COLOR_2;
+    else if (scale_denom == 4) flags = cv::IMREAD_REDUCED_COLOR_4;
+    else if (scale_denom == 8) flags = cv::IMREAD_REDUCED_COLOR_8;
+
+    const cv::Mat buffer(1, static_cast<int>(size), CV_8UC1, const_cast<unsigned char*>(data));
+
+    return cv::imdecode(buffer, flags);
+}
+
+// === OpenCV Encode ===
+bool OpenCvJpegCodec::encode(const cv::Mat& image, std::vector<unsigned char>& out, const JpegEncodeOptions& options) const {
+    if (image.empty()) return false;
+
+    const std::vector<int> params = {
+        cv::IMWRITE_JPEG_QUALITY, options.quality,
+        cv::IMWRITE_JPEG_PROGRESSIVE, options.progressive ? 1 : 0
+    };
+
+    return cv::imencode(".jpg", image, out, params);
+}
+
+#if defined(HAVE_TURBOJPEG)
+// === TurboJPEG Decode ===
+cv::Mat TurboJpegCodec::decode(const unsigned char* data, size_t size, int scale_denom) const {
+    tjhandle handle = turboHandles().decompressor;
+    if (!handle || !data || size == 0 || !isValidScale(scale_denom)) return cv::Mat();
+
+    int width = 0, height = 0, subsampling = 0, colorspace = 0;
+    if (tjDecompressHeader3(handle, data, static_cast<unsigned long>(size), &width, &height, &subsampling, &colorspace) != 0) {
+        std::cerr << "[JPEG] Header error: " << tjGetErrorStr2(handle) << std::endl;
+        return cv::Mat();
+    }
+
+    const tjscalingfactor factor = { 1, scale_denom };
+    const int scaled_width = TJSCALED(width, factor);
+    const int scaled_height = TJSCALED(height, factor);
+
+    // Only scaled (periodic count) decodes trade IDCT accuracy for speed; full-size fall frames keep the accurate IDCT
+    const int flags = scale_denom > 1 ? TJFLAG_FASTDCT : TJFLAG_ACCURATEDCT;
+
+    cv::Mat image(scaled_height, scaled_width, CV_8UC3);
+    if (tjDecompress2(handle, data, static_cast<unsigned long>(size), image.data,
+        scaled_width, static_cast<int>(image.step), scaled_height, TJPF_BGR, flags) != 0) {
+        std::cerr << "[JPEG] Decode error: " << tjGetErrorStr2(handle) << std::endl;
+        return cv::Mat();
+    }
+
+    return image;
+}
+
+// === TurboJPEG Encode ===
+bool TurboJpegCodec::encode(const cv::Mat& image, std::vector<unsigned char>& out, const JpegEncodeOptions& options) const {
+    tjhandle handle = turboHandles().compressor;
+    if (!handle || image.empty() || image.type() != CV_8UC3) return false;
+
+    // Compress straight into the output vector, sized for the worst case
+    out.resize(tjBufSize(image.cols, image.rows, TJSAMP_420));
+    unsigned char* buffer = out.data();
+    unsigned long length = static_cast<unsigned long>(out.size());
+
+    int flags = TJFLAG_NOREALLOC;
+#if defined(TJFLAG_PROGRESSIVE)
+    if (options.progressive) flags |= TJFLAG_PROGRESSIVE;
+#endif
+
+    if (tjCompress2(handle, image.data, image.cols, static_cast<int>(image.step), image.rows, TJPF_BGR,
+        &buffer, &length, TJSAMP_420, options.quality, flags) != 0) {
+        std::cerr << "[JPEG] Encode error: " << tjGetErrorStr2(handle) << std::endl;
+        out.clear();
+        return false;
+    }
+
+    out.resize(length);
+
+    return true;
+}
+#endif
+
+// === Process-wide Codec ===
+const JpegCodec& jpegCodec() {
+#if defined(HAVE_TURBOJPEG)
+    static const TurboJpegCodec turbo;
+    if (JPEG_BACKEND == JpegBackend::TurboJpeg) return turbo;
+#endif
+    static const OpenCvJpegCodec opencv;
+
+    return opencv;
+}
+
+// === Scale Selection ===
+int jpegScaleForTarget(const cv::Size& full_size, int target_long_side) {
+    const int long_side = std::max(full_size.width, full_size.height);
+    if (long_side <= 0 || target_long_side <= 0) return 1;
+
+    int scale_denom = 1;
+    while (scale_denom < 8 && long_side / (scale_denom * 2) >= target_long_side) scale_denom *= 2;
+
+    return scale_denom;
+}
+
+// === Header-only Size Probe ===
+cv::Size jpegImageSize(const unsigned char* data, size_t size) {
+    if (!data || size < 4 || data[0] != 0xFF || data[1] != 0xD8) return cv::Size();
+
+    // Walk the marker segments up to the first start-of-frame
+    size_t pos = 2;
+    while (pos + 4 <= size) {
+        if (data[pos] != 0xFF) return cv::Size();
+
+        const unsigned char marker = data[pos + 1];
+        if (marker == 0xFF) {
+            ++pos;  // Fill byte
+            continue;
+        }
+
+        const size_t length = (static_cast<size_t>(data[pos + 2]) << 8) | data[pos + 3];
+        const bool is_frame = marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC;
+
+        if (is_frame) {
+            if (pos + 9 > size) return cv::Size();
+
+            const int height = (data[pos + 5] << 8) | data[pos + 6];
+            const int width = (data[pos + 7] << 8) | data[pos + 8];
+
+            return cv::Size(width, height);
+        }
+
+        pos += 2 + length;
+    }
+
+    return cv::Size();
+}
@@ -1,77 +1,190 @@
 // Standard Library
 #include <iostream>
 #include <stdexcept>
-#include <cmath>
+#include <algorithm>
+#include <array>
 
 // Project headers
 #include "congestion_analyzer.h"
 
+namespace {
+    constexpr int k_radius = CONGESTION_INFLUENCE_RADIUS;
+    constexpr int k_stamp_side = 2 * k_radius + 1;
+
+    // === Compile-time sqrt (Newton) ===
+    constexpr double constexprSqrt(double value) {
+        if (value <= 0.0) return 0.0;
+
+        double x = value;
+        for (int i = 0; i < 32; ++i) x = 0.5 * (x + value / x);
+        return x;
+    }
+
+    // === Compile-time exp (halving, Taylor series, squaring) ===
+    constexpr double constexprExp(double value) {
+        int halvings = 0;
+        while (value > 0.5 || value < -0.5) {
+            value /= 2.0;
+            ++halvings;
+        }
+
+        double sum = 1.0;
+        double term = 1.0;
+        for (int n = 1; n < 20; ++n) {
+            term *= value / n;
+            sum += term;
+        }
+
+        for (int i = 0; i < halvings; ++i) sum *= sum;
+        return sum;
+    }
+
+    // === Decay Weights exp(-alpha * distance) over the Influence Square ===
+    constexpr std::array<float, k_stamp_side * k_stamp_side> makeDecayStamp() {
+        std::array<float, k_stamp_side * k_stamp_side> stamp{};
+        for (int dy = -k_radius; dy <= k_radius; ++dy) {
+            for (int dx = -k_radius; dx <= k_radius; ++dx) {
+                const double dist = constexprSqrt(static_cast<double>(dx * dx + dy * dy));
+                stamp[(dy + k_radius) * k_stamp_side + (dx + k_radius)] = static_cast<float>(constexprExp(-CONGESTION_DECAY_ALPHA * dist));
+            }
+        }
+        return stamp;
+    }
+
+    constexpr auto k_decay_stamp = makeDecayStamp();
+    static_assert(k_decay_stamp[k_radius * k_stamp_side + k_radius] == 1.0f, "Decay stamp must peak at its center.");
+}
+
 // === Constructor ===
 CongestionAnalyzer::CongestionAnalyzer(int image_width, int image_height)
     : image_size(image_width, image_height),
-    grid_size(GRID_CELL_SIZE),
-    decay_alpha(CONGESTION_DECAY_ALPHA),
-    influence_radius(CONGESTION_INFLUENCE_RADIUS) {
+    grid_size(GRID_CELL_SIZE) {
 }
 
 // === Analyze Congestion based on Crowd Information ===
-std::vector<std::vector<float>> CongestionAnalyzer::analyzeCongestionGrid(const std::vector<cv::Point>& crowd_pixel) {
-    std::vector<std::vector<float>> empty_result;
-
+Grid<float> CongestionAnalyzer::analyzeCongestionGrid(const std::vector<cv::Point>& crowd_pixel) {
     try {
         if (image_size.width <= 0 || image_size.height <= 0 || grid_size <= 0) throw std::runtime_error("Invalid image or grid size.");
 
-        const int rows = image_size.height / grid_size;
-        const int cols = image_size.width / grid_size;
-        std::vector<std::vector<float>> congestion(rows, std::vector<float>(cols, 0.0f));
-
-        for (const auto& person : crowd_pixel) {
-            const cv::Point grid_center = toGrid(person);
+        Grid<float> congestion(image_size.height / grid_size, image_size.width / grid_size);
 
-            for (int dy = -influence_radius; dy <= influence_radius; ++dy) {
-                for (int dx = -influence_radius; dx <= influence_radius; ++dx) {
-                    const int gx = grid_center.x + dx;
-                    const int gy = grid_center.y + dy;
-                    if (gx < 0 || gx >= cols || gy < 0 || gy >= rows) continue;
-
-                    const float dist = std::hypot(static_cast<float>(dx), static_cast<float>(dy));
-                    const float weight = std::exp(-decay_alpha * dist);
-                    congestion[gy][gx] += weight;
-                }
-            }
-        }
+        accumulateCongestion(crowd_pixel, congestion);
+        buildSummedArea(congestion);
 
         return congestion;
     }
     catch (const std::exception& e) {
         std::cerr << "[CongestionAnalyzer::analyzeCongestionGrid] Error: " << e.what() << std::endl;
 
-        return empty_result;
+        summed_area = Grid<double>();
+
+        return Grid<float>();
     }
 }
 
+// === Add Weighted Congestion to a Grid ===
+void CongestionAnalyzer::accumulateCongestion(const std::vector<cv::Point>& crowd_pixel, Grid<float>& congestion, float weight) {
+    // Stamping costs people x stamp; convolving costs cells x stamp but no longer grows with the crowd
+    if (static_cast<int>(crowd_pixel.size()) >= CONGESTION_CONVOLVE_MIN_PEOPLE) scatterThenConvolve(crowd_pixel, congestion, weight);
+    else scatterStamps(crowd_pixel, congestion, weight);
+}
+
+// === Use an External Congestion Grid ===
+void CongestionAnalyzer::loadCongestionGrid(GridView<const float> congestion) {
+    buildSummedArea(congestion);
+}
+
 // === Calculate Average Congestion Around Small Area ===
 float CongestionAnalyzer::calculateAverageCongestionAround(const cv::Point& center_pixel, int radius) {
+    if (summed_area.empty()) return 0.0f;
+
     const cv::Point grid_center = toGrid(center_pixel);
 
-    const int rows = image_size.height / grid_size;
-    const int cols = image_size.width / grid_size;
+    const int x0 = std::max(grid_center.x - radius, 0);
+    const int y0 = std::max(grid_center.y - radius, 0);
+    const int x1 = std::min(grid_center.x + radius, summed_area.cols() - 1);
+    const int y1 = std::min(grid_center.y + radius, summed_area.rows() - 1);
+    if (x0 > x1 || y0 > y1) return 0.0f;
+
+    const double sum = summed_area.at(y1, x1) - summed_area.at(y0 - 1, x1) - summed_area.at(y1, x0 - 1) + summed_area.at(y0 - 1, x0 - 1);
+    const int count = (x1 - x0 + 1) * (y1 - y0 + 1);
+
+    return static_cast<float>(sum / count);
+}
 
-    float sum = 0.0f;
-    int count = 0;
+// === Stamp the Decay Weights around Each Person ===
+void CongestionAnalyzer::scatterStamps(const std::vector<cv::Point>& crowd_pixel, Grid<float>& congestion, float weight) {
+    const int rows = congestion.rows();
+    const int cols = congestion.cols();
 
-    for (int dy = -radius; dy <= radius; ++dy) {
-        for (int dx = -radius; dx <= radius; ++dx) {
-            const int gx = grid_center.x + dx;
-            const int gy = grid_center.y + dy;
-            if (gx < 0 || gx >= cols || gy < 0 || gy >= rows) continue;
+    for (const auto& person : crowd_pixel) {
+        const cv::Point grid_center = toGrid(person);
 
-            const float dist = std::hypot(static_cast<float>(dx), static_cast<float>(dy));
-            const float weight = std::exp(-decay_alpha * dist);
-            sum += weight;
-            ++count;
+        // Clip the stamp to the grid once per person instead of per cell
+        const int dy0 = std::max(-k_radius, -grid_center.y);
+        const int dy1 = std::min(k_radius, rows - 1 - grid_center.y);
+        const int dx0 = std::max(-k_radius, -grid_center.x);
+        const int dx1 = std::min(k_radius, cols - 1 - grid_center.x);
+
+        for (int dy = dy0; dy <= dy1; ++dy) {
+            float* row = congestion.row(grid_center.y + dy) + grid_center.x;
+            const float* weights = k_decay_stamp.data() + (dy + k_radius) * k_stamp_side + k_radius;
+
+            for (int dx = dx0; dx <= dx1; ++dx) {
+                row[dx] += weight * weights[dx];
+            }
         }
     }
+}
+
+// === Count People per Cell, then Convolve with the Decay Stamp ===
+void CongestionAnalyzer::scatterThenConvolve(const std::vector<cv::Point>& crowd_pixel, Grid<float>& congestion, float weight) {
+    const int rows = congestion.rows();
+    const int cols = congestion.cols();
+
+    // Counts are padded by the radius so the convolution needs no bounds checks
+    Grid<float> counts(rows, cols, k_radius, 0.0f);
+
+    for (const auto& person : crowd_pixel) {
+        const cv::Point grid_center = toGrid(person);
+
+        // People farther than the radius outside the grid do not reach it
+        if (!counts.containsPadded(grid_center)) continue;
+        counts.at(grid_center) += weight;
+    }
+
+    // The stamp is symmetric, so convolution and correlation coincide
+    for (int y = 0; y < rows; ++y) {
+        float* out = congestion.row(y);
 
-    return (count > 0) ? (sum / static_cast<float>(count)) : 0.0f;
-}
\ No newline at end of file
+        for (int dy = -k_radius; dy <= k_radius; ++dy) {
+            const float* source = counts.row(y + dy);
+
+            for (int dx = -k_radius; dx <= k_radius; ++dx) {
+                const float stamp_weight = k_decay_stamp[(dy + k_radius) * k_stamp_side + (dx + k_radius)];
+                const float* shifted = source + dx;
+
+                for (int x = 0; x < cols; ++x) {
+                    out[x] += stamp_weight * shifted[x];
+                }
+            }
+        }
+    }
+}
+
+// === Build the Summed-area Table ===
+void CongestionAnalyzer::buildSummedArea(GridView<const float> congestion) {
+    summed_area = Grid<double>(congestion.rows(), congestion.cols(), 1, 0.0);
+
+    for (int y = 0; y < congestion.rows(); ++y) {
+        const float* row = congestion.row(y);
+        const double* above = summed_area.row(y - 1);
+        double* current = summed_area.row(y);
+
+        double row_sum = 0.0;
+        for (int x = 0; x < congestion.cols(); ++x) {
+            row_sum += row[x];
+            current[x] = above[x] + row_sum;
+        }
+    }
+}
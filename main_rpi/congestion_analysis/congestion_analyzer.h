@@ -6,9 +6,13 @@
 
 // Project headers
 #include "config.h"
+#include "grid.h"
 
 /**
  * @brief Computes a congestion heatmap based on detected crowd positions.
+ *
+ * The analyzer keeps the summed-area table of the last grid it computed, so
+ * that area queries after analyzeCongestionGrid() are O(1).
  */
 class CongestionAnalyzer {
 public:
@@ -24,24 +28,52 @@ public:
     /**
      * @brief Analyzes the congestion grid based on current crowd locations.
      * @param Vector of crowd positions in pixel coordinates
-     * @return A 2D float matrix representing the congestion weight per grid cell
+     * @return Grid of the congestion weight per cell (empty on error)
      */
-    std::vector<std::vector<float>> analyzeCongestionGrid(const std::vector<cv::Point>& crowd_pixel);
+    Grid<float> analyzeCongestionGrid(const std::vector<cv::Point>& crowd_pixel);
 
     /**
-     * @brief Calculates the average congestion around a specific position.
+     * @brief Adds the weighted congestion of crowd locations to an existing grid.
+     * @param Vector of crowd positions in pixel coordinates
+     * @param Grid of the image's dimensions in cells
+     * @param Weight of each person's contribution
+     */
+    void accumulateCongestion(const std::vector<cv::Point>& crowd_pixel, Grid<float>& congestion, float weight = 1.0f);
+
+    /**
+     * @brief Uses a grid computed elsewhere (e.g. the CongestionModel) for the queries below.
+     * @param Congestion grid
+     */
+    void loadCongestionGrid(GridView<const float> congestion);
+
+    /**
+     * @brief Calculates the average congestion of the last analyzed grid around a specific position.
      * @param Center pixel position
      * @param Radius in grid cells (default: CONGESTION_INFLUENCE_RADIUS)
-     * @return Averaged congestion weight
+     * @return Averaged congestion weight over the cells of the square inside the grid (0 before any analysis)
      */
     float calculateAverageCongestionAround(const cv::Point& center_pixel, int radius = CONGESTION_INFLUENCE_RADIUS);
 
 private:
+    /**
+     * @brief Adds the decay stamp of every person to the grid.
+     */
+    void scatterStamps(const std::vector<cv::Point>& crowd_pixel, Grid<float>& congestion, float weight);
+
+    /**
+     * @brief Counts people per cell, then convolves the counts with the decay stamp.
+     */
+    void scatterThenConvolve(const std::vector<cv::Point>& crowd_pixel, Grid<float>& congestion, float weight);
+
+    /**
+     * @brief Rebuilds the summed-area table from the grid.
+     */
+    void buildSummedArea(GridView<const float> congestion);
+
     // === Members ===
     cv::Size image_size;
     int grid_size;
-    float decay_alpha;
-    int influence_radius;
+    Grid<double> summed_area;   ///< Inclusive prefix sums; the zero padding stands for row and column -1
 };
 
-#endif  // CONGESTION_ANALYZER_H
\ No newline at end of file
+#endif  // CONGESTION_ANALYZER_H
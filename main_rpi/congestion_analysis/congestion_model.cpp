@@ -0,0 +1,105 @@
+// Standard Library
+#include <cmath>
+#include <algorithm>
+
+// Project headers
+#include "congestion_model.h"
+
+namespace {
+    // Below this, the accumulated weights are renormalized (scale) or forgotten (total weight)
+    constexpr double k_min_scale = 1e-3;
+    constexpr double k_min_weight = 1e-4;
+}
+
+// === Constructor ===
+CongestionModel::CongestionModel(std::chrono::milliseconds time_constant)
+    : time_constant_ms(static_cast<double>(std::max<std::chrono::milliseconds::rep>(time_constant.count(), 1))),
+    scale(1.0),
+    total_weight(0.0),
+    observation_count(0) {
+}
+
+// === Add One Observation ===
+void CongestionModel::update(const cv::Size& frame_size, const std::vector<cv::Point>& crowd_pixel, Clock::time_point observed_at) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (frame_size != image_size || weighted_sum.empty()) restart(frame_size);
+    if (weighted_sum.empty()) return;
+
+    double weight = 1.0;
+    if (observation_count > 0) {
+        const double elapsed_ms = std::chrono::duration<double, std::milli>(observed_at - last_observed).count();
+
+        if (elapsed_ms >= 0.0) {
+            // Everything so far ages by the time since the last observation
+            const double decay = std::exp(-elapsed_ms / time_constant_ms);
+            scale *= decay;
+            total_weight *= decay;
+            last_observed = observed_at;
+        }
+        else {
+            // A late observation (e.g. a slower inference job) enters already aged
+            weight = std::exp(elapsed_ms / time_constant_ms);
+        }
+    }
+    else {
+        last_observed = observed_at;
+    }
+
+    // Nothing of the old observations is left: start over rather than divide by ~0
+    if (total_weight < k_min_weight) {
+        weighted_sum.fill(0.0f);
+        scale = 1.0;
+        total_weight = 0.0;
+    }
+
+    // Fold the decay into the cells before it underflows the float precision
+    if (scale < k_min_scale) {
+        const float factor = static_cast<float>(scale);
+        for (int y = 0; y < weighted_sum.rows(); ++y) {
+            float* row = weighted_sum.row(y);
+            for (int x = 0; x < weighted_sum.cols(); ++x) row[x] *= factor;
+        }
+        scale = 1.0;
+    }
+
+    CongestionAnalyzer analyzer(image_size.width, image_size.height);
+    analyzer.accumulateCongestion(crowd_pixel, weighted_sum, static_cast<float>(weight / scale));
+    total_weight += weight;
+    ++observation_count;
+}
+
+// === Current Grid ===
+Grid<float> CongestionModel::snapshot(const cv::Size& frame_size, Clock::time_point now, std::chrono::milliseconds max_age) const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (observation_count == 0 || frame_size != image_size || total_weight < k_min_weight) return Grid<float>();
+    if (now - last_observed > max_age) return Grid<float>();
+
+    const float factor = static_cast<float>(scale / total_weight);
+    Grid<float> grid(weighted_sum.rows(), weighted_sum.cols());
+    for (int y = 0; y < grid.rows(); ++y) {
+        const float* source = weighted_sum.row(y);
+        float* target = grid.row(y);
+        for (int x = 0; x < grid.cols(); ++x) target[x] = source[x] * factor;
+    }
+
+    return grid;
+}
+
+// === Number of Observations ===
+size_t CongestionModel::observations() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return observation_count;
+}
+
+// === Restart for a Frame Size ===
+void CongestionModel::restart(const cv::Size& frame_size) {
+    image_size = frame_size;
+    weighted_sum = (frame_size.width > 0 && frame_size.height > 0)
+        ? Grid<float>(frame_size.height / GRID_CELL_SIZE, frame_size.width / GRID_CELL_SIZE, 0, 0.0f)
+        : Grid<float>();
+    scale = 1.0;
+    total_weight = 0.0;
+    observation_count = 0;
+}
@@ -0,0 +1,78 @@
+#ifndef CONGESTION_MODEL_H
+#define CONGESTION_MODEL_H
+
+// Standard Library
+#include <mutex>
+#include <vector>
+#include <chrono>
+
+// Project headers
+#include "congestion_analyzer.h"
+#include "grid.h"
+#include "config.h"
+
+/**
+ * @brief Rolling congestion grid, updated from every people detection with exponential time decay.
+ *
+ * The grid is the exponentially weighted average of the congestion grids of
+ * all observations: an observation that is t old weighs exp(-t / time constant).
+ * Each update only stamps the new people (the decay of the old ones is a
+ * common factor), so feeding every periodic detection costs no more than
+ * analyzing it once. Thread-safe.
+ */
+class CongestionModel {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Constructs an empty model.
+     * @param Time constant of the decay (default: CONGESTION_MODEL_TIME_CONSTANT_MS)
+     */
+    explicit CongestionModel(std::chrono::milliseconds time_constant = std::chrono::milliseconds(CONGESTION_MODEL_TIME_CONSTANT_MS));
+
+    ~CongestionModel() = default;
+
+    CongestionModel(const CongestionModel&) = delete;
+    CongestionModel& operator=(const CongestionModel&) = delete;
+
+    /**
+     * @brief Adds one observation.
+     * @param Full-resolution size of the frame the positions are in; a new size restarts the model
+     * @param People positions in pixel coordinates of that size
+     * @param When the frame was observed (may be older than the last observation)
+     */
+    void update(const cv::Size& image_size, const std::vector<cv::Point>& crowd_pixel, Clock::time_point observed_at);
+
+    /**
+     * @brief Returns the current grid.
+     * @param Frame size the grid is wanted for
+     * @param Current time
+     * @param Age of the last observation beyond which the model is not used
+     * @return The averaged grid; empty if the model has no observation of that size within the age
+     */
+    Grid<float> snapshot(const cv::Size& image_size, Clock::time_point now,
+        std::chrono::milliseconds max_age = std::chrono::milliseconds(CONGESTION_MODEL_MAX_AGE_MS)) const;
+
+    /**
+     * @brief Returns the number of observations since the model (re)started.
+     */
+    size_t observations() const;
+
+private:
+    /**
+     * @brief Clears the model for a frame size.
+     */
+    void restart(const cv::Size& image_size);
+
+    // === Members ===
+    mutable std::mutex mutex;
+    double time_constant_ms;
+    cv::Size image_size;
+    Grid<float> weighted_sum;           ///< Sum of weighted grids, divided by scale
+    double scale;                       ///< Decay applied to weighted_sum since the last renormalization
+    double total_weight;                ///< Sum of the observation weights
+    Clock::time_point last_observed;
+    size_t observation_count;
+};
+
+#endif  // CONGESTION_MODEL_H
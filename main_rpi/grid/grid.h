@@ -0,0 +1,232 @@
+#ifndef GRID_H
+#define GRID_H
+
+// Standard Library
+#include <memory>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+// OpenCV
+#include <opencv2/core.hpp>
+
+/**
+ * @brief Non-owning window onto rows x cols cells of a Grid (or any row-major buffer).
+ *
+ * Cells are addressed as at(row, col) or at(cv::Point(x, y)), like cv::Mat.
+ * GridView<T> converts to GridView<const T>. A view must not outlive its grid.
+ */
+template <typename T>
+class GridView {
+public:
+    GridView() = default;
+
+    /**
+     * @brief Wraps an existing buffer.
+     * @param Pointer to the cell (0, 0)
+     * @param Number of rows
+     * @param Number of columns
+     * @param Distance between rows in cells
+     */
+    GridView(T* origin, int rows, int cols, size_t stride)
+        : origin(origin), row_count(rows), col_count(cols), row_stride(stride) {
+    }
+
+    template <typename U, typename = std::enable_if_t<std::is_same<const U, T>::value && !std::is_same<U, T>::value>>
+    GridView(const GridView<U>& other)
+        : origin(other.data()), row_count(other.rows()), col_count(other.cols()), row_stride(other.stride()) {
+    }
+
+    int rows() const { return row_count; }
+    int cols() const { return col_count; }
+    size_t stride() const { return row_stride; }
+    bool empty() const { return row_count <= 0 || col_count <= 0; }
+    cv::Size size() const { return cv::Size(col_count, row_count); }
+    T* data() const { return origin; }
+
+    T* row(int y) const { return origin + static_cast<std::ptrdiff_t>(y) * static_cast<std::ptrdiff_t>(row_stride); }
+    T& at(int y, int x) const { return row(y)[x]; }
+    T& at(const cv::Point& cell) const { return row(cell.y)[cell.x]; }
+
+    /**
+     * @brief Returns true if the cell lies inside the view.
+     */
+    bool contains(const cv::Point& cell) const {
+        return cell.x >= 0 && cell.y >= 0 && cell.x < col_count && cell.y < row_count;
+    }
+
+    /**
+     * @brief Returns the cell value, or the fallback outside the view.
+     */
+    std::remove_const_t<T> valueOr(const cv::Point& cell, std::remove_const_t<T> fallback) const {
+        return contains(cell) ? at(cell) : fallback;
+    }
+
+    /**
+     * @brief Returns the sub-window clipped to the view.
+     */
+    GridView sub(const cv::Rect& cells) const {
+        const cv::Rect clipped = cells & cv::Rect(0, 0, col_count, row_count);
+        if (clipped.empty()) return GridView();
+        return GridView(&at(clipped.y, clipped.x), clipped.height, clipped.width, row_stride);
+    }
+
+    /**
+     * @brief Wraps the cells as a cv::Mat header without copying.
+     *
+     * The Mat shares the memory; it is only valid as long as the grid is, and
+     * must not be written through when T is const.
+     */
+    cv::Mat asMat() const {
+        using Element = std::remove_const_t<T>;
+        return cv::Mat(row_count, col_count, cv::DataType<Element>::type,
+            const_cast<Element*>(origin), row_stride * sizeof(Element));
+    }
+
+private:
+    T* origin = nullptr;
+    int row_count = 0;
+    int col_count = 0;
+    size_t row_stride = 0;
+};
+
+/**
+ * @brief Owning, contiguous row-major grid with an optional border of padding cells.
+ *
+ * The padding surrounds the rows x cols cells on every side, so stencils can
+ * read up to padding() cells outside without bounds checks: at(-1, -1) is
+ * valid when padding() >= 1. Padding cells are initialized like the others.
+ *
+ * Grids are move-only; copies are explicit through clone().
+ */
+template <typename T>
+class Grid {
+public:
+    Grid() = default;
+
+    /**
+     * @brief Allocates a grid.
+     * @param Number of rows
+     * @param Number of columns
+     * @param Padding cells on every side
+     * @param Initial value of every cell, padding included
+     */
+    Grid(int rows, int cols, int padding = 0, const T& value = T()) {
+        if (rows < 0 || cols < 0 || padding < 0) throw std::invalid_argument("Negative grid dimension.");
+
+        row_count = rows;
+        col_count = cols;
+        pad = padding;
+        row_stride = static_cast<size_t>(cols) + 2 * static_cast<size_t>(padding);
+        cell_count = row_stride * (static_cast<size_t>(rows) + 2 * static_cast<size_t>(padding));
+
+        storage.reset(new T[cell_count]);
+        std::fill(storage.get(), storage.get() + cell_count, value);
+    }
+
+    Grid(Grid&& other) noexcept { swap(other); }
+
+    Grid& operator=(Grid&& other) noexcept {
+        Grid(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    Grid(const Grid&) = delete;
+    Grid& operator=(const Grid&) = delete;
+
+    /**
+     * @brief Returns a deep copy, padding included.
+     */
+    Grid clone() const {
+        Grid copy;
+        copy.row_count = row_count;
+        copy.col_count = col_count;
+        copy.pad = pad;
+        copy.row_stride = row_stride;
+        copy.cell_count = cell_count;
+        if (cell_count > 0) {
+            copy.storage.reset(new T[cell_count]);
+            std::copy(storage.get(), storage.get() + cell_count, copy.storage.get());
+        }
+        return copy;
+    }
+
+    void swap(Grid& other) noexcept {
+        std::swap(storage, other.storage);
+        std::swap(row_count, other.row_count);
+        std::swap(col_count, other.col_count);
+        std::swap(pad, other.pad);
+        std::swap(row_stride, other.row_stride);
+        std::swap(cell_count, other.cell_count);
+    }
+
+    int rows() const { return row_count; }
+    int cols() const { return col_count; }
+    int padding() const { return pad; }
+    size_t stride() const { return row_stride; }
+    bool empty() const { return row_count <= 0 || col_count <= 0; }
+    cv::Size size() const { return cv::Size(col_count, row_count); }
+
+    T* row(int y) { return origin() + static_cast<std::ptrdiff_t>(y) * static_cast<std::ptrdiff_t>(row_stride); }
+    const T* row(int y) const { return origin() + static_cast<std::ptrdiff_t>(y) * static_cast<std::ptrdiff_t>(row_stride); }
+    T& at(int y, int x) { return row(y)[x]; }
+    const T& at(int y, int x) const { return row(y)[x]; }
+    T& at(const cv::Point& cell) { return row(cell.y)[cell.x]; }
+    const T& at(const cv::Point& cell) const { return row(cell.y)[cell.x]; }
+
+    /**
+     * @brief Returns true if the cell lies inside the grid (padding excluded).
+     */
+    bool contains(const cv::Point& cell) const {
+        return cell.x >= 0 && cell.y >= 0 && cell.x < col_count && cell.y < row_count;
+    }
+
+    /**
+     * @brief Returns true if the cell lies inside the grid or its padding.
+     */
+    bool containsPadded(const cv::Point& cell) const {
+        return cell.x >= -pad && cell.y >= -pad && cell.x < col_count + pad && cell.y < row_count + pad;
+    }
+
+    /**
+     * @brief Returns the cell value, or the fallback outside the grid.
+     */
+    T valueOr(const cv::Point& cell, const T& fallback) const {
+        return contains(cell) ? at(cell) : fallback;
+    }
+
+    /**
+     * @brief Sets every cell, padding included.
+     */
+    void fill(const T& value) {
+        std::fill(storage.get(), storage.get() + cell_count, value);
+    }
+
+    GridView<T> view() { return GridView<T>(origin(), row_count, col_count, row_stride); }
+    GridView<const T> view() const { return GridView<const T>(origin(), row_count, col_count, row_stride); }
+    GridView<T> view(const cv::Rect& cells) { return view().sub(cells); }
+    GridView<const T> view(const cv::Rect& cells) const { return view().sub(cells); }
+
+    operator GridView<T>() { return view(); }
+    operator GridView<const T>() const { return view(); }
+
+    /**
+     * @brief Wraps the cells (padding excluded) as a cv::Mat header without copying.
+     */
+    cv::Mat asMat() { return view().asMat(); }
+    cv::Mat asMat() const { return view().asMat(); }
+
+private:
+    T* origin() { return storage.get() + pad * row_stride + pad; }
+    const T* origin() const { return storage.get() + pad * row_stride + pad; }
+
+    std::unique_ptr<T[]> storage;
+    int row_count = 0;
+    int col_count = 0;
+    int pad = 0;
+    size_t row_stride = 0;
+    size_t cell_count = 0;
+};
+
+#endif  // GRID_H
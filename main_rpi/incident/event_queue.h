@@ -0,0 +1,126 @@
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+// Standard Library
+#include <atomic>
+#include <optional>
+#include <utility>
+#include <cstdint>
+#include <cerrno>
+#include <system_error>
+
+// System Library
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+/**
+ * @brief Unbounded multi-producer, single-consumer event queue.
+ *
+ * push() is lock-free (one atomic exchange per event) and may be called from
+ * any thread: MQTT callbacks, capture watcher, inference workers. Only one
+ * thread may call tryPop() / wait(). An eventfd wakes the consumer, so it can
+ * sleep until an event, a deadline or another descriptor without polling.
+ */
+template <typename T>
+class EventQueue
+{
+public:
+    EventQueue()
+        : head(new Node()),
+        tail(head.load()),
+        wake_fd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    {
+        // Without the eventfd the consumer would sleep through every push
+        if (wake_fd < 0)
+        {
+            const int error = errno;
+            delete tail;
+            throw std::system_error(error, std::generic_category(), "eventfd");
+        }
+    }
+
+    ~EventQueue()
+    {
+        while (tail)
+        {
+            Node* next = tail->next.load(std::memory_order_relaxed);
+            delete tail;
+            tail = next;
+        }
+
+        close(wake_fd);
+    }
+
+    EventQueue(const EventQueue&) = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+
+    /**
+     * @brief Appends an event and wakes the consumer (any thread).
+     * @param Event
+     */
+    void push(T value)
+    {
+        Node* node = new Node();
+        node->value.emplace(std::move(value));
+
+        Node* previous = head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+
+        const uint64_t one = 1;
+        [[maybe_unused]] ssize_t written = write(wake_fd, &one, sizeof(one));
+    }
+
+    /**
+     * @brief Takes the oldest event, if any (consumer thread only).
+     * @param Output event
+     * @return false if the queue is empty
+     */
+    bool tryPop(T& out)
+    {
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next) return false;
+
+        out = std::move(*next->value);
+        next->value.reset();
+
+        delete tail;
+        tail = next;  // The popped node becomes the new stub
+
+        return true;
+    }
+
+    /**
+     * @brief Sleeps until an event is pushed or another descriptor is readable (consumer thread only).
+     * @param Descriptor to wait on as well (e.g. a timerfd), or -1 to wait for events only
+     */
+    void wait(int other_fd)
+    {
+        if (!tail->next.load(std::memory_order_acquire))
+        {
+            pollfd descriptors[2] = { { wake_fd, POLLIN, 0 }, { other_fd, POLLIN, 0 } };
+            poll(descriptors, other_fd >= 0 ? 2 : 1, -1);
+        }
+
+        uint64_t count = 0;
+        [[maybe_unused]] ssize_t read_bytes = read(wake_fd, &count, sizeof(count));
+    }
+
+    /**
+     * @brief Returns the wake-up descriptor, readable while events are pending.
+     */
+    int fd() const { return wake_fd; }
+
+private:
+    struct Node
+    {
+        std::atomic<Node*> next{ nullptr };
+        std::optional<T> value;
+    };
+
+    std::atomic<Node*> head;  // Last pushed node (producers)
+    Node* tail;               // Stub before the oldest event (consumer)
+    int wake_fd;
+};
+
+#endif // EVENT_QUEUE_H
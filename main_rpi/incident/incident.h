@@ -0,0 +1,210 @@
+#ifndef INCIDENT_H
+#define INCIDENT_H
+
+// Standard Library
+#include <array>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+// OpenCV
+#include <opencv2/opencv.hpp>
+
+// Project headers
+#include "path_finder.h"
+#include "capture_watcher.h"
+#include "timer_scheduler.h"
+#include "config.h"
+
+/**
+ * @brief Stage of a fall incident, in the order it is walked.
+ */
+enum class IncidentState
+{
+    Idle,       ///< Not open (before its trigger or after its reset)
+    Triggered,  ///< Capture requested, waiting for the CH1 image
+    Captured,   ///< CH1 image in; fall analysis running and/or sub-camera counts pending
+    Counted,    ///< Fall confirmed and every count in (or the count deadline passed); route being planned
+    Routed,     ///< Gate selected; LED command and results being published
+    Published   ///< Results out; closes, or waits for late counts if some were estimated
+};
+
+/**
+ * @brief Result of the fall detector on the CH1 capture of an incident.
+ */
+struct FallAnalysis
+{
+    bool fall_detected = false;
+    cv::Mat image;                          ///< Full-resolution CH1 frame
+    cv::Point fall_center = { -1, -1 };     ///< Center of the fallen person, in capture pixels
+    std::vector<cv::Point> people;          ///< Centers of the other people in CH1
+    std::chrono::steady_clock::time_point analyzed_at;     ///< Fall detector done
+};
+
+/**
+ * @brief Count-independent part of the route, computed speculatively after fall analysis.
+ *
+ * Congestion and A* per exit depend only on the CH1 people and the exit
+ * layout, so they run while the sub-camera counts are still on their way;
+ * routing then only scores the candidates and draws the selected path.
+ */
+struct RouteCandidates
+{
+    bool ok = false;
+    uint64_t exit_version = 0;              ///< Exit layout the paths were computed for
+    std::vector<Exit> exits;                ///< Exits in pixel coordinates, snapped to grid centers
+    std::vector<PathInfo> paths;            ///< Path, path cost and inner congestion per exit, same order; not scored
+    cv::Point fall_center_pixel = { -1, -1 };
+    cv::Mat base_image;                     ///< CH1 frame with the congestion heatmap and exits drawn
+    std::chrono::steady_clock::time_point congestion_done;
+    std::chrono::steady_clock::time_point path_done;
+    std::chrono::steady_clock::time_point visual_done;
+};
+
+/**
+ * @brief Gate selection and rendered result of an incident.
+ */
+struct RoutePlan
+{
+    bool ok = false;                        ///< false if no exit was reachable
+    std::vector<Exit> exits;                ///< Exits in pixel coordinates, snapped to grid centers
+    std::vector<PathInfo> paths;            ///< One entry per exit, same order, scored
+    int selected_gate_index = -1;
+    float score = 0.0f;
+    std::array<int, SUB_CAMERA_COUNT> counts = {};          ///< Sub-camera counts the route was planned with
+    std::array<bool, SUB_CAMERA_COUNT> estimated = {};      ///< Counts that were estimates, not received
+    std::vector<uchar> path_image;          ///< Encoded once; published and archived
+    std::chrono::steady_clock::time_point rescore_done;
+    std::chrono::steady_clock::time_point visual_done;
+    std::chrono::steady_clock::time_point encode_done;
+};
+
+/**
+ * @brief Stage timestamps of an incident, for the time log summary.
+ */
+struct IncidentTimes
+{
+    std::chrono::steady_clock::time_point triggered;
+    std::chrono::steady_clock::time_point captured;
+    std::chrono::steady_clock::time_point counted;
+    std::chrono::steady_clock::time_point led_done;
+    std::chrono::steady_clock::time_point published;
+};
+
+/**
+ * @brief Everything known about one fall incident; owned by the IncidentController.
+ */
+struct Incident
+{
+    uint64_t id = 0;
+    std::string timestamp;                  ///< fall_event_timestamp, known once the CH1 capture is in
+    IncidentState state = IncidentState::Idle;
+    bool analyzed = false;                  ///< FallAnalysis received
+    FallAnalysis analysis;
+    RouteCandidates candidates;             ///< Arrives with the analysis
+    std::array<int, SUB_CAMERA_COUNT> sub_counts;           ///< Received counts (-1 until received)
+    std::array<int, SUB_CAMERA_COUNT> route_counts = {};    ///< Counts to route with: received, or estimated after the deadline
+    std::array<bool, SUB_CAMERA_COUNT> count_estimated = {};
+    bool count_deadline_passed = false;     ///< SUB_COUNT_TIMEOUT_MS passed; missing counts are estimated
+    int published_gate = -1;                ///< Gate of the last published route (-1 before the first publish)
+    RoutePlan plan;
+    IncidentTimes times;
+    TimerId capture_timer = 0;              ///< CAPTURE_TIMEOUT_MS from the trigger; cancelled by the capture
+    TimerId count_timer = 0;                ///< SUB_COUNT_TIMEOUT_MS from the trigger, then the late-count window after publishing
+    TimerId incident_timer = 0;             ///< INCIDENT_TIMEOUT_MS from the trigger
+
+    Incident() { sub_counts.fill(-1); }
+
+    bool allCountsReceived() const
+    {
+        for (int count : sub_counts)
+        {
+            if (count < 0) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Returns true if a count received since the last route was an estimate in it.
+     */
+    bool lateCountsChangeRoute() const
+    {
+        for (size_t i = 0; i < sub_counts.size(); ++i)
+        {
+            if (plan.estimated[i] && sub_counts[i] >= 0) return true;
+        }
+        return false;
+    }
+};
+
+/**
+ * @brief Kind of input to the incident state machine.
+ */
+enum class IncidentEventType
+{
+    FallTrigger,        ///< MQTT pi/data/fall
+    PeriodicTrigger,    ///< MQTT pi/data/Count
+    Captured,           ///< CH1 fall capture completed (frame attached)
+    FallAnalyzed,       ///< Fall job finished (analysis attached)
+    SubCount,           ///< MQTT sub/capture/<n>
+    Routed,             ///< Routing job finished (plan attached)
+    OffOrder            ///< MQTT qt/off
+};
+
+/**
+ * @brief One input to the incident state machine.
+ *
+ * Results of worker jobs carry the id of the incident they were started for,
+ * so results of an incident that has since been reset are dropped.
+ */
+struct IncidentEvent
+{
+    IncidentEventType type = IncidentEventType::FallTrigger;
+    uint64_t incident_id = 0;  ///< FallAnalyzed, Routed; SubCount: incident the count answers (0 if not given)
+    std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+    std::string timestamp;      ///< Captured: event timestamp from the capture file name
+    size_t camera_index = 0;    ///< SubCount: 1-based sub-camera index
+    int count = -1;             ///< SubCount: people count
+    CaptureFrame frame;         ///< Captured
+    FallAnalysis analysis;      ///< FallAnalyzed
+    RouteCandidates candidates; ///< FallAnalyzed (speculative paths, if a fall was found)
+    RoutePlan plan;             ///< Routed
+};
+
+/**
+ * @brief Counters over all incidents handled by the controller.
+ */
+struct IncidentStats
+{
+    size_t opened = 0;              ///< Triggers that opened an incident
+    size_t ignored = 0;             ///< Triggers dropped because MAX_CONCURRENT_INCIDENTS were open
+    size_t published = 0;           ///< Incidents that published a route
+    size_t estimated = 0;           ///< First routes published with at least one estimated count
+    size_t rerouted = 0;            ///< Routes republished because a late count changed the gate
+    size_t aborted = 0;             ///< Incidents reset before publishing
+    size_t peak_concurrent = 0;     ///< Most incidents open at once
+    float total_latency_ms = 0.0f;  ///< Sum of trigger-to-publish times of published incidents
+    float max_latency_ms = 0.0f;    ///< Longest trigger-to-publish time
+
+    float averageLatencyMs() const { return published ? total_latency_ms / published : 0.0f; }
+};
+
+/**
+ * @brief Returns a printable name of an incident state.
+ */
+inline const char* incidentStateName(IncidentState state)
+{
+    switch (state)
+    {
+    case IncidentState::Idle: return "idle";
+    case IncidentState::Triggered: return "triggered";
+    case IncidentState::Captured: return "captured";
+    case IncidentState::Counted: return "counted";
+    case IncidentState::Routed: return "routed";
+    case IncidentState::Published: return "published";
+    }
+    return "unknown";
+}
+
+#endif // INCIDENT_H
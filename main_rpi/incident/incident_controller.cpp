@@ -0,0 +1,495 @@
+// Standard Library
+#include <iostream>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+
+// Project headers
+#include "incident_controller.h"
+#include "tracer.h"
+
+namespace {
+    long long elapsedMs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(to - from).count();
+    }
+
+    std::string incidentLabel(const Incident& incident)
+    {
+        std::string label = "#" + std::to_string(incident.id);
+        if (!incident.timestamp.empty()) label += " (" + incident.timestamp + ")";
+        return label;
+    }
+}
+
+// === Constructor ===
+IncidentController::IncidentController(IncidentEventQueue& events, IncidentActions& actions)
+    : events(events),
+    actions(actions),
+    next_id(1)
+{
+}
+
+// === Applies queued events and due timers ===
+void IncidentController::processEvents()
+{
+    // No timer pending means no timeout: sleep until the next event
+    events.wait(timer_scheduler.fd());
+
+    // Events first, so a result arriving together with its timeout still counts
+    IncidentEvent event;
+    while (events.tryPop(event))
+    {
+        handle(event);
+    }
+
+    timer_scheduler.expire();
+}
+
+// === Applies one event ===
+void IncidentController::handle(IncidentEvent& event)
+{
+    switch (event.type)
+    {
+    case IncidentEventType::FallTrigger:
+        onFallTrigger(event);
+        break;
+
+    case IncidentEventType::PeriodicTrigger:
+        if (incidents.empty()) actions.armPeriodicCapture();
+        break;
+
+    case IncidentEventType::Captured:
+        onCaptured(event);
+        break;
+
+    case IncidentEventType::FallAnalyzed:
+        onFallAnalyzed(event);
+        break;
+
+    case IncidentEventType::SubCount:
+        onSubCount(event);
+        break;
+
+    case IncidentEventType::Routed:
+        onRouted(event);
+        break;
+
+    case IncidentEventType::OffOrder:
+        if (!incidents.empty())
+        {
+            std::cout << "[INCIDENT] Qt announced emergency situation is over." << std::endl;
+            while (!incidents.empty()) resetIncident(incidents.front().id, "off order from Qt");
+        }
+
+        // The sub-cameras turn their LEDs off on the same order
+        for (const auto& [gate_index, timer] : led_timers) timer_scheduler.cancel(timer);
+        led_timers.clear();
+        break;
+    }
+}
+
+// === Fall trigger: opens an incident if there is room ===
+void IncidentController::onFallTrigger(const IncidentEvent& event)
+{
+    // Incidents already published and only waiting for late counts leave their slot
+    const size_t active = std::count_if(incidents.begin(), incidents.end(), [](const Incident& incident) {
+        return incident.published_gate < 0;
+        });
+    if (active >= MAX_CONCURRENT_INCIDENTS)
+    {
+        ++incident_stats.ignored;
+        std::cout << "[EVENT] Ignored fall trigger: " << active << " incidents already in progress" << std::endl;
+        return;
+    }
+
+    incidents.emplace_back();
+    Incident& incident = incidents.back();
+    incident.id = next_id++;
+    incident.times.triggered = event.time;
+    incident.capture_timer = scheduleTimeout(incident, CAPTURE_TIMEOUT_MS, IncidentState::Triggered, "no CH1 capture");
+    incident.count_timer = scheduleCountDeadline(incident);
+    incident.incident_timer = scheduleTimeout(incident, INCIDENT_TIMEOUT_MS, IncidentState::Published, "timeout");
+
+    ++incident_stats.opened;
+    incident_stats.peak_concurrent = std::max(incident_stats.peak_concurrent, incidents.size());
+
+    std::cout << "[EVENT] Fall event triggered via MQTT (incident #" << incident.id
+        << ", " << incidents.size() << " open)" << std::endl;
+
+    transition(incident, IncidentState::Triggered);
+    actions.requestCapture(incident);
+}
+
+// === CH1 capture arrived: keys the oldest waiting incident and starts fall analysis ===
+void IncidentController::onCaptured(IncidentEvent& event)
+{
+    auto it = std::find_if(incidents.begin(), incidents.end(), [](const Incident& incident) {
+        return incident.state == IncidentState::Triggered;
+        });
+    if (it == incidents.end())
+    {
+        std::cout << "[EVENT] Ignored CH1 capture " << event.frame.name << ": no incident waiting for one" << std::endl;
+        return;
+    }
+
+    Incident& incident = *it;
+    timer_scheduler.cancel(incident.capture_timer);
+    incident.capture_timer = 0;
+    incident.timestamp = event.timestamp;
+    incident.times.captured = event.time;
+    tracer().record(TraceStage::TriggerToImage, incident.times.captured - incident.times.triggered);
+    std::cout << "[PERF] Incident " << incidentLabel(incident) << ": time from fall trigger to EventRule_1-CH1 image arrival: "
+        << elapsedMs(incident.times.triggered, event.time) << " ms" << std::endl;
+
+    transition(incident, IncidentState::Captured);
+
+    if (!actions.analyzeCapture(incident, std::move(event.frame)))
+    {
+        std::cerr << "[EVENT] Fall job not queued" << std::endl;
+        resetIncident(incident.id, "fall job rejected");
+    }
+}
+
+// === Fall analysis finished ===
+void IncidentController::onFallAnalyzed(IncidentEvent& event)
+{
+    Incident* incident = find(event.incident_id);
+    if (!incident || incident->state != IncidentState::Captured)
+    {
+        std::cout << "[EVENT] Dropped fall analysis of incident #" << event.incident_id << std::endl;
+        return;
+    }
+
+    if (!event.analysis.fall_detected)
+    {
+        resetIncident(incident->id, "no fall detected");
+        return;
+    }
+
+    incident->analysis = std::move(event.analysis);
+    incident->candidates = std::move(event.candidates);
+    incident->analyzed = true;
+
+    routeIfReady(*incident);
+}
+
+// === Sub-camera count: goes to the incident whose capture request it answers ===
+void IncidentController::onSubCount(const IncidentEvent& event)
+{
+    if (event.camera_index < 1 || event.camera_index > SUB_CAMERA_COUNT)
+    {
+        std::cerr << "[CROWD] Invalid camera index: " << event.camera_index << std::endl;
+        return;
+    }
+
+    const size_t slot = event.camera_index - 1;
+    last_counts[slot] = { event.count, event.time };
+
+    Incident* target = nullptr;
+    if (event.incident_id != 0)
+    {
+        // The count echoes the incident id of the request; a camera that missed a request never answers for it
+        target = find(event.incident_id);
+        if (!target || target->sub_counts[slot] >= 0)
+        {
+            std::cout << "[CROWD] Ignored sub-camera crowd count for incident #" << event.incident_id << ": closed or already counted." << std::endl;
+            return;
+        }
+    }
+    else
+    {
+        // Without an id, prefer the oldest incident not yet routed, then the oldest still missing this camera
+        auto missing = [slot](const Incident& incident) { return incident.sub_counts[slot] < 0; };
+        auto it = std::find_if(incidents.begin(), incidents.end(), [&missing](const Incident& incident) {
+            return missing(incident) && incident.published_gate < 0;
+            });
+        if (it == incidents.end()) it = std::find_if(incidents.begin(), incidents.end(), missing);
+        if (it == incidents.end())
+        {
+            std::cout << "[CROWD] Ignored sub-camera crowd count: not expecting results now." << std::endl;
+            return;
+        }
+        target = &*it;
+    }
+
+    Incident& incident = *target;
+    incident.sub_counts[slot] = event.count;
+    std::cout << "[CROWD] Incident #" << incident.id << " sub_camera_crowd_counts[" << slot << "] = " << event.count << std::endl;
+
+    if (incident.allCountsReceived() && incident.published_gate < 0)
+    {
+        timer_scheduler.cancel(incident.count_timer);
+        incident.count_timer = 0;
+    }
+
+    if (incident.state == IncidentState::Published)
+    {
+        // A late count: plan again with it, the published route stays until the new one differs
+        std::cout << "[CROWD] Late count for incident #" << incident.id << ", re-routing" << std::endl;
+        startRouting(incident);
+        return;
+    }
+
+    // While routing, onRouted() checks for counts that arrived meanwhile
+    routeIfReady(incident);
+}
+
+// === Starts routing once the fall is confirmed and every count is in or overdue ===
+void IncidentController::routeIfReady(Incident& incident)
+{
+    if (incident.state != IncidentState::Captured || !incident.analyzed) return;
+    if (!incident.allCountsReceived() && !incident.count_deadline_passed) return;
+
+    startRouting(incident);
+}
+
+// === Fills in the counts to route with and hands the incident to a routing job ===
+void IncidentController::startRouting(Incident& incident)
+{
+    const auto now = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < incident.sub_counts.size(); ++i)
+    {
+        const bool missing = incident.sub_counts[i] < 0;
+        incident.count_estimated[i] = missing;
+        incident.route_counts[i] = missing ? estimateCount(i, now) : incident.sub_counts[i];
+
+        if (missing)
+            std::cout << "[CROWD] Incident #" << incident.id << " gate " << i + 1 << " count estimated as " << incident.route_counts[i] << std::endl;
+    }
+
+    incident.times.counted = now;
+    transition(incident, IncidentState::Counted);
+
+    if (!actions.planRoute(incident))
+    {
+        std::cerr << "[EVENT] Routing job not queued" << std::endl;
+        resetIncident(incident.id, "routing job rejected");
+    }
+}
+
+// === Last known count of a camera, decayed by its age ===
+int IncidentController::estimateCount(size_t slot, std::chrono::steady_clock::time_point now) const
+{
+    const LastCount& last = last_counts[slot];
+    if (last.count < 0) return 0;  // Never heard from: no penalty for that gate
+
+    const float age_ms = std::chrono::duration<float, std::milli>(now - last.received).count();
+    const float decay = std::exp2(-age_ms / SUB_COUNT_HALF_LIFE_MS);
+
+    return static_cast<int>(std::lround(last.count * decay));
+}
+
+// === Route planned: publish if the gate is new, then close or wait for late counts ===
+void IncidentController::onRouted(IncidentEvent& event)
+{
+    Incident* incident = find(event.incident_id);
+    if (!incident || incident->state != IncidentState::Counted)
+    {
+        std::cout << "[EVENT] Dropped route of incident #" << event.incident_id << std::endl;
+        return;
+    }
+
+    const bool first_route = incident->published_gate < 0;
+    incident->plan = std::move(event.plan);
+    if (!incident->plan.ok)
+    {
+        if (first_route) actions.publish(*incident);  // Reports the failure
+        resetIncident(incident->id, first_route ? "no path to any exit" : "re-route failed, previous route stands");
+        return;
+    }
+
+    const int gate = incident->plan.selected_gate_index;
+    transition(*incident, IncidentState::Routed);
+
+    if (first_route)
+    {
+        actions.publish(*incident);
+        scheduleLedOff(gate);
+
+        incident->times.published = std::chrono::steady_clock::now();
+        tracer().record(TraceStage::TriggerToPublish, incident->times.published - incident->times.triggered);
+
+        const float latency_ms = std::chrono::duration<float, std::milli>(incident->times.published - incident->times.triggered).count();
+        ++incident_stats.published;
+        incident_stats.total_latency_ms += latency_ms;
+        incident_stats.max_latency_ms = std::max(incident_stats.max_latency_ms, latency_ms);
+
+        const bool estimated = std::find(incident->plan.estimated.begin(), incident->plan.estimated.end(), true) != incident->plan.estimated.end();
+        if (estimated) ++incident_stats.estimated;
+
+        std::cout << "[PERF] Incident " << incidentLabel(*incident) << ": trigger to results published in "
+            << static_cast<long>(latency_ms) << " ms (" << incidents.size() << " open"
+            << (estimated ? ", estimated counts" : "") << ")" << std::endl;
+    }
+    else if (gate != incident->published_gate)
+    {
+        std::cout << "[PATH] Incident " << incidentLabel(*incident) << ": late counts moved the route from gate "
+            << incident->published_gate + 1 << " to gate " << gate + 1 << std::endl;
+
+        turnOffGate(incident->published_gate, incident->id);
+        actions.republish(*incident);
+        scheduleLedOff(gate);
+        ++incident_stats.rerouted;
+    }
+    else
+    {
+        std::cout << "[PATH] Incident " << incidentLabel(*incident) << ": late counts keep gate " << gate + 1 << std::endl;
+    }
+
+    incident->published_gate = gate;
+    transition(*incident, IncidentState::Published);
+
+    if (incident->lateCountsChangeRoute())
+    {
+        startRouting(*incident);  // A count arrived while this route was planned
+        return;
+    }
+
+    if (incident->allCountsReceived())
+    {
+        resetIncident(incident->id, "cycle complete");
+        return;
+    }
+
+    // Keep listening for the missing counts for a while
+    if (first_route)
+    {
+        const uint64_t id = incident->id;
+        timer_scheduler.cancel(incident->count_timer);
+        incident->count_timer = timer_scheduler.scheduleAfter(std::chrono::milliseconds(SUB_COUNT_LATE_WINDOW_MS), [this, id]() {
+            resetIncident(id, "late-count window over");
+            });
+    }
+}
+
+// === Returns the open incident with an id ===
+Incident* IncidentController::find(uint64_t id)
+{
+    for (auto& incident : incidents)
+    {
+        if (incident.id == id) return &incident;
+    }
+    return nullptr;
+}
+
+// === Schedules a reset unless the incident has moved past a state ===
+TimerId IncidentController::scheduleTimeout(const Incident& incident, int timeout_ms, IncidentState last_state, const char* reason)
+{
+    const uint64_t id = incident.id;
+    const auto due = incident.times.triggered + std::chrono::milliseconds(timeout_ms);
+
+    return timer_scheduler.schedule(due, [this, id, timeout_ms, last_state, reason]() {
+        Incident* incident = find(id);
+        if (!incident || incident->state > last_state) return;
+
+        std::cout << "[TIMEOUT] Incident " << incidentLabel(*incident) << " still " << incidentStateName(incident->state)
+            << " after " << timeout_ms << " ms (" << reason << ")" << std::endl;
+        resetIncident(id, reason);
+        });
+}
+
+// === Deadline after which missing counts are estimated ===
+TimerId IncidentController::scheduleCountDeadline(const Incident& incident)
+{
+    const uint64_t id = incident.id;
+    const auto due = incident.times.triggered + std::chrono::milliseconds(SUB_COUNT_TIMEOUT_MS);
+
+    return timer_scheduler.schedule(due, [this, id]() {
+        Incident* incident = find(id);
+        if (!incident || incident->state > IncidentState::Captured) return;
+
+        incident->count_timer = 0;
+        incident->count_deadline_passed = true;
+
+        std::cout << "[TIMEOUT] Incident " << incidentLabel(*incident) << ": sub-camera counts missing after "
+            << SUB_COUNT_TIMEOUT_MS << " ms, routing with estimates" << std::endl;
+        routeIfReady(*incident);
+        });
+}
+
+// === Turns a gate LED off now, unless another open incident still shows it ===
+void IncidentController::turnOffGate(int gate_index, uint64_t owner_id)
+{
+    for (const auto& incident : incidents)
+    {
+        if (incident.id != owner_id && incident.published_gate == gate_index) return;
+    }
+
+    auto it = led_timers.find(gate_index);
+    if (it != led_timers.end())
+    {
+        timer_scheduler.cancel(it->second);
+        led_timers.erase(it);
+    }
+
+    actions.turnOffGateLed(gate_index);
+}
+
+// === Keeps a gate LED on for LED_ON_DURATION_MS ===
+void IncidentController::scheduleLedOff(int gate_index)
+{
+    if (gate_index < 0) return;
+
+    // A later incident routed to the same gate extends it
+    auto it = led_timers.find(gate_index);
+    if (it != led_timers.end()) timer_scheduler.cancel(it->second);
+
+    led_timers[gate_index] = timer_scheduler.scheduleAfter(std::chrono::milliseconds(LED_ON_DURATION_MS), [this, gate_index]() {
+        led_timers.erase(gate_index);
+        std::cout << "[TIMEOUT] Gate " << gate_index + 1 << " LED auto-off after " << LED_ON_DURATION_MS << " ms" << std::endl;
+        actions.turnOffGateLed(gate_index);
+        });
+}
+
+// === Cancels the timers of an incident ===
+void IncidentController::cancelTimers(Incident& incident)
+{
+    for (TimerId* timer : { &incident.capture_timer, &incident.count_timer, &incident.incident_timer })
+    {
+        timer_scheduler.cancel(*timer);
+        *timer = 0;
+    }
+}
+
+// === Hands an incident to the reset action and closes it ===
+void IncidentController::resetIncident(uint64_t id, const char* reason)
+{
+    auto it = std::find_if(incidents.begin(), incidents.end(), [id](const Incident& incident) {
+        return incident.id == id;
+        });
+    if (it == incidents.end()) return;
+
+    if (it->published_gate < 0) ++incident_stats.aborted;
+
+    cancelTimers(*it);
+    actions.reset(*it, reason);
+
+    std::cout << "[STATE] Incident " << incidentLabel(*it) << " closed (" << reason << "). "
+        << incidents.size() - 1 << " still open." << std::endl;
+
+    incidents.erase(it);  // Late results of this incident no longer find it
+}
+
+// === Moves an incident to a new state ===
+void IncidentController::transition(Incident& incident, IncidentState next)
+{
+    std::cout << "[STATE] Incident #" << incident.id << ": " << incidentStateName(incident.state)
+        << " -> " << incidentStateName(next) << std::endl;
+    incident.state = next;
+}
+
+// === Prints the incident counters ===
+void IncidentController::printStats() const
+{
+    std::cout << "[INCIDENT] opened " << incident_stats.opened
+        << ", published " << incident_stats.published
+        << " (" << incident_stats.estimated << " with estimated counts, " << incident_stats.rerouted << " re-routed)"
+        << ", aborted " << incident_stats.aborted
+        << ", ignored " << incident_stats.ignored
+        << ", open " << incidents.size()
+        << ", peak concurrent " << incident_stats.peak_concurrent
+        << ", latency avg " << static_cast<long>(incident_stats.averageLatencyMs())
+        << " ms / max " << static_cast<long>(incident_stats.max_latency_ms) << " ms" << std::endl;
+}
@@ -0,0 +1,232 @@
+#ifndef INCIDENT_CONTROLLER_H
+#define INCIDENT_CONTROLLER_H
+
+// Standard Library
+#include <map>
+#include <array>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+// Project headers
+#include "incident.h"
+#include "event_queue.h"
+#include "timer_scheduler.h"
+
+using IncidentEventQueue = EventQueue<IncidentEvent>;
+
+/**
+ * @brief Side effects of the incident state machine, implemented by the main server.
+ *
+ * Every method is called on the controller thread. Long work (fall analysis,
+ * routing) is handed to workers, which report back by pushing an event.
+ */
+class IncidentActions
+{
+public:
+    virtual ~IncidentActions() = default;
+
+    /**
+     * @brief Requests the CH1 capture of a new incident and arms the fall rule.
+     */
+    virtual void requestCapture(const Incident& incident) = 0;
+
+    /**
+     * @brief Arms the periodic capture rule (only called while no incident is open).
+     */
+    virtual void armPeriodicCapture() = 0;
+
+    /**
+     * @brief Starts fall analysis of the CH1 capture; the result arrives as FallAnalyzed.
+     *
+     * On a fall the job also computes the route candidates, so routing only rescores them.
+     * @return false if the job could not be queued
+     */
+    virtual bool analyzeCapture(const Incident& incident, CaptureFrame frame) = 0;
+
+    /**
+     * @brief Scores the route candidates with the incident's counts and renders the result; arrives as Routed.
+     * @return false if the job could not be queued
+     */
+    virtual bool planRoute(const Incident& incident) = 0;
+
+    /**
+     * @brief Sends the LED command and publishes and archives the results of a routed incident.
+     */
+    virtual void publish(Incident& incident) = 0;
+
+    /**
+     * @brief Sends the LED command and publishes the results again after late counts moved the route.
+     *
+     * Archiving and the archive writer hold were settled by the first publish().
+     */
+    virtual void republish(Incident& incident) = 0;
+
+    /**
+     * @brief Turns off the LED of a gate whose LED_ON_DURATION_MS has passed or whose incident re-routed.
+     * @param 0-based gate index
+     */
+    virtual void turnOffGateLed(int gate_index) = 0;
+
+    /**
+     * @brief Releases everything held for an incident that is being reset.
+     *
+     * An incident still in Triggered has its capture outstanding; the
+     * implementation withdraws one expected capture for it.
+     * @param Incident in the state it is left in
+     * @param Reason for logs
+     */
+    virtual void reset(const Incident& incident, const char* reason) = 0;
+};
+
+/**
+ * @brief Single-consumer state machine of the fall cycle.
+ *
+ * All events go through one queue and are applied on the thread that calls
+ * processEvents(), so state is never shared between threads. Up to
+ * MAX_CONCURRENT_INCIDENTS incidents are open at once, each with its own
+ * counts, analysis and route. Inputs that do not name an incident are matched
+ * in trigger order: a CH1 capture goes to the oldest incident still waiting
+ * for one, and a sub-camera count to the oldest incident still missing that
+ * camera.
+ *
+ * Routing does not wait for a slow sub-camera past SUB_COUNT_TIMEOUT_MS: the
+ * missing counts are estimated from the last count of that camera, halved
+ * every SUB_COUNT_HALF_LIFE_MS. The incident then stays open for
+ * SUB_COUNT_LATE_WINDOW_MS, and a late count re-plans the route; the new
+ * route is published only if it selects another gate.
+ *
+ * Capture, sub-count and incident timeouts and the LED auto-off are timers on
+ * a monotonic TimerScheduler, polled together with the event queue, so the
+ * controller wakes exactly when something is due and sleeps otherwise.
+ */
+class IncidentController
+{
+public:
+    /**
+     * @brief Constructs the controller.
+     * @param Queue the events arrive on
+     * @param Side effects
+     */
+    IncidentController(IncidentEventQueue& events, IncidentActions& actions);
+
+    IncidentController(const IncidentController&) = delete;
+    IncidentController& operator=(const IncidentController&) = delete;
+
+    /**
+     * @brief Sleeps until an event arrives or a timer is due, then applies queued events and due timers.
+     */
+    void processEvents();
+
+    /**
+     * @brief Applies one event.
+     */
+    void handle(IncidentEvent& event);
+
+    /**
+     * @brief Returns the open incidents, oldest first.
+     */
+    const std::vector<Incident>& openIncidents() const { return incidents; }
+
+    /**
+     * @brief Returns the counters over all incidents.
+     */
+    const IncidentStats& stats() const { return incident_stats; }
+
+    /**
+     * @brief Prints the incident counters and trigger-to-publish latency.
+     */
+    void printStats() const;
+
+    /**
+     * @brief Returns the scheduler the controller sleeps on; other periodic work of the loop may be added to it.
+     */
+    TimerScheduler& timers() { return timer_scheduler; }
+
+private:
+    void onFallTrigger(const IncidentEvent& event);
+    void onCaptured(IncidentEvent& event);
+    void onFallAnalyzed(IncidentEvent& event);
+    void onSubCount(const IncidentEvent& event);
+    void onRouted(IncidentEvent& event);
+
+    /**
+     * @brief Returns the open incident with an id, or nullptr.
+     */
+    Incident* find(uint64_t id);
+
+    /**
+     * @brief Starts routing once the fall is confirmed and every count is in or the count deadline passed.
+     */
+    void routeIfReady(Incident& incident);
+
+    /**
+     * @brief Fills in received or estimated counts and queues the routing job.
+     */
+    void startRouting(Incident& incident);
+
+    /**
+     * @brief Returns the last count of a camera decayed by its age, or 0 if none was received.
+     */
+    int estimateCount(size_t slot, std::chrono::steady_clock::time_point now) const;
+
+    /**
+     * @brief Schedules a timer that resets an incident unless it has moved past a state by then.
+     * @param Incident
+     * @param Timeout from the trigger
+     * @param Last state the timeout applies to
+     * @param Reason for logs
+     */
+    TimerId scheduleTimeout(const Incident& incident, int timeout_ms, IncidentState last_state, const char* reason);
+
+    /**
+     * @brief Schedules SUB_COUNT_TIMEOUT_MS from the trigger, after which missing counts are estimated.
+     */
+    TimerId scheduleCountDeadline(const Incident& incident);
+
+    /**
+     * @brief Turns a gate LED off now unless another open incident still shows that gate.
+     */
+    void turnOffGate(int gate_index, uint64_t owner_id);
+
+    /**
+     * @brief Keeps a gate LED on for LED_ON_DURATION_MS from now.
+     */
+    void scheduleLedOff(int gate_index);
+
+    /**
+     * @brief Cancels the timers of an incident.
+     */
+    void cancelTimers(Incident& incident);
+
+    /**
+     * @brief Hands an incident to IncidentActions::reset() and closes it.
+     */
+    void resetIncident(uint64_t id, const char* reason);
+
+    /**
+     * @brief Moves an incident to a new state, logging the transition.
+     */
+    void transition(Incident& incident, IncidentState next);
+
+    /**
+     * @brief Last count received from a sub-camera, for estimates.
+     */
+    struct LastCount
+    {
+        int count = -1;
+        std::chrono::steady_clock::time_point received;
+    };
+
+    // === Members ===
+    IncidentEventQueue& events;
+    IncidentActions& actions;
+    std::vector<Incident> incidents;  ///< Open incidents in trigger order
+    IncidentStats incident_stats;
+    TimerScheduler timer_scheduler;
+    std::map<int, TimerId> led_timers;  ///< LED auto-off timer per lit gate
+    std::array<LastCount, SUB_CAMERA_COUNT> last_counts;
+    uint64_t next_id;
+};
+
+#endif // INCIDENT_CONTROLLER_H
@@ -0,0 +1,35 @@
+#ifndef ORT_RUNTIME_H
+#define ORT_RUNTIME_H
+
+// Standard Library
+#include <memory>
+#include <string>
+
+// ONNX Runtime
+#include <onnxruntime_cxx_api.h>
+
+/**
+ * @brief Process-wide ONNX Runtime environment and session cache.
+ *
+ * All sessions share one Ort::Env with a global intra-op thread pool, so the
+ * fall and crowd models never oversubscribe the CPU with per-session pools.
+ */
+class OrtRuntime {
+public:
+    OrtRuntime() = delete;
+
+    /**
+     * @brief Get the shared ORT environment (created on first use)
+     * @return Process-wide environment
+     */
+    static Ort::Env& getEnv();
+
+    /**
+     * @brief Get or create the session for a model path (thread-safe)
+     * @param Path to ONNX model
+     * @return Shared session
+     */
+    static std::shared_ptr<Ort::Session> getSharedSession(const std::string& model_path);
+};
+
+#endif  // ORT_RUNTIME_H
@@ -0,0 +1,387 @@
+#ifndef YOLO_ENGINE_H
+#define YOLO_ENGINE_H
+
+// Standard Library
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ONNX Runtime
+#include <onnxruntime_cxx_api.h>
+
+// Project headers
+#include "input_size_policy.h"
+#include "tracer.h"
+#include "yolo_layout.h"
+#include "yolo_nms.h"
+#include "yolo_preprocessor.h"
+
+/**
+ * @brief Tiled inference settings.
+ */
+struct YoloTileOptions {
+    bool enabled = false;                                 ///< Use tiles in inferFrame()
+    int tile_size = TILE_SIZE;                            ///< Tile edge in image pixels
+    float overlap = TILE_OVERLAP;                         ///< Fraction of a tile shared with its neighbour
+    bool include_full_frame = TILE_INCLUDE_FULL_FRAME;    ///< Add a letterboxed full-frame pass
+    float merge_threshold = TILE_MERGE_THRESHOLD;         ///< Intersection over smaller box for cross-tile merging
+};
+
+/**
+ * @brief Per-detector settings for a YOLO engine.
+ */
+struct YoloEngineOptions {
+    const char* tag = "YoloEngine";                   ///< Prefix used in log messages
+    float conf_threshold = 0.25f;                     ///< Minimum detection confidence
+    float nms_threshold = 0.45f;                      ///< IoU above which lower-scored boxes are suppressed
+    int class_filter = -1;                            ///< Class to keep (-1 keeps all classes)
+    ModelPrecision precision = ModelPrecision::FP32;  ///< Requested model variant (falls back to FP32)
+    InputSizeMode size_mode = InputSizeMode::Fixed;   ///< Input size selection for inferAdaptive()
+    YoloTileOptions tiling;                           ///< Tiled inference for inferFrame()
+};
+
+/**
+ * @brief Layout-independent part of the engine: session, I/O binding and preprocessing.
+ *
+ * Models with dynamic spatial axes get one persistent input tensor per size in
+ * YOLO_INPUT_SIZES; the binding is switched only when the requested size changes.
+ */
+class YoloEngineBase {
+public:
+    /**
+     * @brief Check whether the ONNX session was created
+     * @return True when inference can run
+     */
+    bool isReady() const;
+
+    /**
+     * @brief Get the precision actually in use (FP32 after a fallback)
+     * @return Active model precision
+     */
+    ModelPrecision activePrecision() const;
+
+    /**
+     * @brief Check whether a batch-dynamic session is available
+     * @return True when inferBatch() runs several images per session call
+     */
+    bool supportsBatch() const;
+
+    /**
+     * @brief Get the input sizes this model can run at
+     * @return Square input sizes, ascending
+     */
+    std::vector<int> inputSizes() const;
+
+    /**
+     * @brief Change tiled inference settings
+     * @param Tile settings
+     */
+    void setTiling(const YoloTileOptions& tiling);
+
+    /**
+     * @brief Get tiled inference settings
+     * @return Tile settings
+     */
+    YoloTileOptions tiling() const;
+
+    /**
+     * @brief Split an image into overlapping tiles, the last row/column aligned to the image edge
+     * @param Image size
+     * @param Tile edge in pixels
+     * @param Overlap fraction
+     * @return Tile rectangles in image coordinates
+     */
+    static std::vector<cv::Rect> tileGrid(const cv::Size& image_size, int tile_size, float overlap);
+
+    /**
+     * @brief Check whether a box reaches a tile edge that lies inside the image (a seam)
+     * @param Box in tile coordinates
+     * @param Tile rectangle in image coordinates
+     * @param Image size
+     * @return True when the box may be cut by the seam
+     */
+    static bool touchesSeam(const cv::Rect& box, const cv::Rect& tile, const cv::Size& image_size);
+
+    /**
+     * @brief Run warm-up inference at every input size to initialize ONNX engine
+     */
+    void runWarmUp();
+
+protected:
+    YoloEngineBase(const std::string& model_path, const YoloEngineOptions& options);
+    ~YoloEngineBase() = default;
+
+    // === Inference core (caller holds inference_mutex) ===
+    Ort::Value& runInference(const cv::Mat& image, int input_size, float& scale, int& top, int& left);
+    Ort::Value& runBatchInference(const cv::Mat* images, size_t count, std::vector<YoloLetterbox>& letterboxes);
+
+    // === Members ===
+    YoloEngineOptions options;
+    mutable std::mutex inference_mutex;  ///< Serializes use of the persistent buffers
+    InputSizePolicy size_policy; ///< Size chosen by inferAdaptive() (guarded by inference_mutex)
+    YoloNms nms;                 ///< NMS scratch (guarded by inference_mutex)
+
+private:
+    void initialize(const std::string& model_path);
+    void bindIo();
+    void initializeBatch(const std::string& model_path);
+    void addInputSlot(int width, int height);
+    void selectInputSlot(int input_size);
+    void warmUpSlots();
+
+    struct InputSlot {
+        int size;                        ///< Input width (square except for static non-square models)
+        YoloPreprocessor preprocessor;   ///< Letterbox for this size
+        Ort::Value tensor{ nullptr };    ///< Persistent ORT-owned 1x3xHxW input
+    };
+
+    std::shared_ptr<Ort::Session> session;
+    ModelPrecision active_precision = ModelPrecision::FP32;
+    std::vector<InputSlot> input_slots;   ///< One per supported input size, ascending
+    size_t active_slot = 0;               ///< Slot currently bound as input
+    Ort::IoBinding io_binding{ nullptr }; ///< Input/output bound once in the constructor
+    Ort::Value bound_output{ nullptr };   ///< Preallocated output (static shape) or last ORT output
+    bool has_static_output = false;
+    std::string input_name;               ///< Cached model input name
+    std::string output_name;              ///< Cached model output name
+
+    std::shared_ptr<Ort::Session> batch_session;  ///< Session with a dynamic batch axis (may be the main session)
+    YoloPreprocessor batch_preprocessor;          ///< Batches always run at the full input size
+    std::vector<float> batch_buffer;              ///< YOLO_MAX_BATCH_SIZE x 3 x H x W input storage
+    Ort::Value batch_input{ nullptr };            ///< N x 3 x H x W view over batch_buffer
+    Ort::IoBinding batch_binding{ nullptr };
+    Ort::Value batch_output{ nullptr };
+    std::string batch_input_name;
+    std::string batch_output_name;
+};
+
+/**
+ * @brief YOLO inference engine with output decoding fixed at compile time.
+ * @tparam OutputLayout Decoder for the model output (YoloV8Layout or YoloV5Layout)
+ */
+template <typename OutputLayout>
+class YoloEngine : public YoloEngineBase {
+public:
+    /**
+     * @brief Constructor with model path and detector settings
+     * @param Path to YOLO ONNX model
+     * @param Detector settings
+     */
+    YoloEngine(const std::string& model_path, const YoloEngineOptions& options)
+        : YoloEngineBase(model_path, options) {
+    }
+
+    ~YoloEngine() = default;
+
+    /**
+     * @brief Run detection on an input image
+     * @param Input BGR image
+     * @param Square input size (the largest supported size not above it is used)
+     * @return Detections after NMS, in image coordinates
+     */
+    std::vector<YoloDetection> infer(const cv::Mat& image, int input_size = YOLO_INPUT_WIDTH) {
+        std::vector<YoloDetection> results;
+
+        try {
+            if (!isReady()) {
+                std::cerr << "[" << options.tag << "::detect] Skipping detection: session not initialized." << std::endl;
+
+                return results;
+            }
+
+            std::lock_guard<std::mutex> lock(inference_mutex);
+
+            inferLocked(image, input_size, results);
+        }
+        catch (const std::exception& e) {
+            std::cerr << "[" << options.tag << "::detect] Error: " << e.what() << std::endl;
+        }
+
+        return results;
+    }
+
+    /**
+     * @brief Run detection on a whole frame, over tiles when tiling is enabled
+     * @param Input BGR image
+     * @return Detections after NMS, in image coordinates
+     */
+    std::vector<YoloDetection> inferFrame(const cv::Mat& image) {
+        const YoloTileOptions tile_options = tiling();
+
+        return tile_options.enabled ? inferTiled(image, tile_options) : infer(image);
+    }
+
+    /**
+     * @brief Run detection over overlapping tiles and merge them with cross-tile NMS
+     * @param Input BGR image
+     * @param Tile settings
+     * @return Detections after merging, in image coordinates
+     */
+    std::vector<YoloDetection> inferTiled(const cv::Mat& image, const YoloTileOptions& tile_options) {
+        std::vector<YoloDetection> results;
+
+        const std::vector<cv::Rect> tiles = tileGrid(image.size(), tile_options.tile_size, tile_options.overlap);
+        if (tiles.size() <= 1) return infer(image);
+
+        std::vector<cv::Mat> views;
+        views.reserve(tiles.size() + 1);
+        for (const auto& tile : tiles) views.push_back(image(tile));
+        if (tile_options.include_full_frame) views.push_back(image);
+
+        // Tiles go through the batch path, so one session call spreads them over the intra-op pool
+        const std::vector<std::vector<YoloDetection>> per_view = inferBatch(views);
+
+        try {
+            std::lock_guard<std::mutex> lock(inference_mutex);
+
+            merged.clear();
+            merged_views.clear();
+            merged_on_seam.clear();
+            for (size_t v = 0; v < per_view.size(); ++v) {
+                const bool is_tile = v < tiles.size();
+                const cv::Point offset = is_tile ? tiles[v].tl() : cv::Point(0, 0);
+
+                for (const auto& det : per_view[v]) {
+                    merged.boxes.push_back(det.bbox + offset);
+                    merged.scores.push_back(det.conf);
+                    merged.class_ids.push_back(det.class_id);
+                    merged_views.push_back(static_cast<int>(v));
+                    merged_on_seam.push_back(is_tile && touchesSeam(det.bbox, tiles[v], image.size()) ? 1 : 0);
+                }
+            }
+
+            // Only duplicates across views are merged; a person cut by a seam leaves a partial box inside the full one, so those pairs use IoS
+            TraceSpan merge_span(TraceStage::Nms);
+            for (int idx : nms.runViewMerge(merged.boxes, merged.scores, merged.class_ids, merged_views, merged_on_seam,
+                options.nms_threshold, tile_options.merge_threshold)) {
+                results.push_back({ merged.boxes[idx], merged.scores[idx], merged.class_ids[idx] });
+            }
+        }
+        catch (const std::exception& e) {
+            std::cerr << "[" << options.tag << "::detectTiled] Error: " << e.what() << std::endl;
+        }
+
+        return results;
+    }
+
+    /**
+     * @brief Run detection at the input size chosen by the size policy, then update the policy
+     * @param Input BGR image
+     * @return Detections after NMS, in image coordinates
+     */
+    std::vector<YoloDetection> inferAdaptive(const cv::Mat& image) {
+        std::vector<YoloDetection> results;
+
+        try {
+            if (!isReady()) {
+                std::cerr << "[" << options.tag << "::detectAdaptive] Skipping detection: session not initialized." << std::endl;
+
+                return results;
+            }
+
+            std::lock_guard<std::mutex> lock(inference_mutex);
+
+            const int input_size = size_policy.current();
+            const auto t0 = std::chrono::steady_clock::now();
+
+            inferLocked(image, input_size, results);
+
+            const float elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            size_policy.update(results.size(), elapsed);
+
+            if (size_policy.current() != input_size) {
+                std::cout << "[" << options.tag << "::detectAdaptive] Input size " << input_size << " -> " << size_policy.current()
+                    << " (" << results.size() << " detections, " << elapsed << " ms)" << std::endl;
+            }
+        }
+        catch (const std::exception& e) {
+            std::cerr << "[" << options.tag << "::detectAdaptive] Error: " << e.what() << std::endl;
+        }
+
+        return results;
+    }
+
+    /**
+     * @brief Run detection on several images, YOLO_MAX_BATCH_SIZE per session call
+     * @param Input BGR images
+     * @return Detections per input image, in the same order
+     */
+    std::vector<std::vector<YoloDetection>> inferBatch(const std::vector<cv::Mat>& images) {
+        std::vector<std::vector<YoloDetection>> results(images.size());
+
+        // Without a batch-dynamic model the images go through the single-image path
+        if (!supportsBatch()) {
+            for (size_t i = 0; i < images.size(); ++i) {
+                results[i] = infer(images[i]);
+            }
+
+            return results;
+        }
+
+        try {
+            std::lock_guard<std::mutex> lock(inference_mutex);
+
+            for (size_t begin = 0; begin < images.size(); begin += YOLO_MAX_BATCH_SIZE) {
+                const size_t count = std::min(images.size() - begin, static_cast<size_t>(YOLO_MAX_BATCH_SIZE));
+                Ort::Value& output = runBatchInference(&images[begin], count, letterboxes);
+
+                const float* data = output.GetTensorData<float>();
+                if (!data) throw std::runtime_error("Output tensor data is null.");
+
+                const std::vector<int64_t> shape = output.GetTensorTypeAndShapeInfo().GetShape();
+                if (shape.empty() || shape[0] != static_cast<int64_t>(count)) throw std::runtime_error("Unexpected batch output shape.");
+
+                // Each image owns a contiguous slice of the output; decode it with the single-image shape
+                const size_t per_image = output.GetTensorTypeAndShapeInfo().GetElementCount() / count;
+
+                for (size_t i = 0; i < count; ++i) {
+                    collect(data + i * per_image, shape, letterboxes[i], results[begin + i]);
+                }
+            }
+        }
+        catch (const std::exception& e) {
+            std::cerr << "[" << options.tag << "::detectBatch] Error: " << e.what() << std::endl;
+        }
+
+        return results;
+    }
+
+private:
+    // Single-image inference at a given size (caller holds inference_mutex)
+    void inferLocked(const cv::Mat& image, int input_size, std::vector<YoloDetection>& results) {
+        float scale;
+        int top, left;
+        Ort::Value& output = runInference(image, input_size, scale, top, left);
+
+        const float* data = output.GetTensorData<float>();
+        if (!data) throw std::runtime_error("Output tensor data is null.");
+
+        collect(data, output.GetTensorTypeAndShapeInfo().GetShape(), { scale, top, left }, results);
+    }
+
+    // Decode one image's output slice and append its detections after NMS
+    void collect(const float* data, const std::vector<int64_t>& shape, const YoloLetterbox& letterbox, std::vector<YoloDetection>& results) {
+        {
+            TraceSpan span(TraceStage::TensorDecode);
+            candidates.clear();
+            OutputLayout::decode(data, shape, options.conf_threshold, options.class_filter, letterbox.scale, letterbox.top, letterbox.left, candidates);
+        }
+
+        TraceSpan span(TraceStage::Nms);
+        for (int idx : nms.run(candidates.boxes, candidates.scores, options.nms_threshold)) {
+            results.push_back({ candidates.boxes[idx], candidates.scores[idx], candidates.class_ids[idx] });
+        }
+    }
+
+    YoloCandidates candidates;              ///< Decode scratch reused between calls
+    YoloCandidates merged;                  ///< Cross-tile merge scratch
+    std::vector<int> merged_views;          ///< View of each merged box
+    std::vector<uint8_t> merged_on_seam;    ///< Whether each merged box touches a tile seam
+    std::vector<YoloLetterbox> letterboxes; ///< Per-image letterbox of the current batch
+};
+
+#endif  // YOLO_ENGINE_H
@@ -0,0 +1,129 @@
+// Standard Library
+#include <algorithm>
+
+// SIMD (NEON kernels need AArch64 for vdivq_f32 / vmaxvq_u32)
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define YOLO_SIMD_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define YOLO_SIMD_SSE2 1
+#endif
+
+// Project headers
+#include "yolo_simd.h"
+
+// === Running Maximum ===
+void simdMaxInPlace(float* dst, const float* src, size_t count) {
+    size_t i = 0;
+
+#if defined(YOLO_SIMD_NEON)
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(dst + i, vmaxq_f32(vld1q_f32(dst + i), vld1q_f32(src + i)));
+    }
+#elif defined(YOLO_SIMD_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_max_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        dst[i] = std::max(dst[i], src[i]);
+    }
+}
+
+// === Threshold Scan ===
+size_t simdSelectAbove(const float* scores, size_t count, float threshold, uint32_t* indices) {
+    size_t n = 0;
+    size_t i = 0;
+
+    // Most blocks have no survivor; only blocks with a set lane are expanded
+#if defined(YOLO_SIMD_NEON)
+    const float32x4_t thr = vdupq_n_f32(threshold);
+
+    for (; i + 4 <= count; i += 4) {
+        const uint32x4_t mask = vcgtq_f32(vld1q_f32(scores + i), thr);
+        if (vmaxvq_u32(mask) == 0) continue;
+
+        for (size_t k = 0; k < 4; ++k) {
+            if (scores[i + k] > threshold) indices[n++] = static_cast<uint32_t>(i + k);
+        }
+    }
+#elif defined(YOLO_SIMD_SSE2)
+    const __m128 thr = _mm_set1_ps(threshold);
+
+    for (; i + 4 <= count; i += 4) {
+        int bits = _mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(scores + i), thr));
+
+        while (bits) {
+            const int k = __builtin_ctz(bits);
+            indices[n++] = static_cast<uint32_t>(i + k);
+            bits &= bits - 1;
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        if (scores[i] > threshold) indices[n++] = static_cast<uint32_t>(i);
+    }
+
+    return n;
+}
+
+// === Overlap Sweep Against One Kept Box ===
+void simdSuppressOverlaps(const float* x1, const float* y1, const float* x2, const float* y2, const float* area,
+    size_t begin, size_t end, size_t ref, float threshold, OverlapMetric metric, uint8_t* suppressed) {
+    const bool over_smaller = (metric == OverlapMetric::IoS);
+    size_t j = begin;
+
+#if defined(YOLO_SIMD_NEON)
+    const float32x4_t rx1 = vdupq_n_f32(x1[ref]), ry1 = vdupq_n_f32(y1[ref]);
+    const float32x4_t rx2 = vdupq_n_f32(x2[ref]), ry2 = vdupq_n_f32(y2[ref]);
+    const float32x4_t rarea = vdupq_n_f32(area[ref]);
+    const float32x4_t zero = vdupq_n_f32(0.0f), eps = vdupq_n_f32(1e-6f), thr = vdupq_n_f32(threshold);
+
+    for (; j + 4 <= end; j += 4) {
+        const float32x4_t w = vmaxq_f32(zero, vsubq_f32(vminq_f32(rx2, vld1q_f32(x2 + j)), vmaxq_f32(rx1, vld1q_f32(x1 + j))));
+        const float32x4_t h = vmaxq_f32(zero, vsubq_f32(vminq_f32(ry2, vld1q_f32(y2 + j)), vmaxq_f32(ry1, vld1q_f32(y1 + j))));
+        const float32x4_t inter = vmulq_f32(w, h);
+        const float32x4_t other = vld1q_f32(area + j);
+        const float32x4_t denom = over_smaller ? vminq_f32(rarea, other) : vsubq_f32(vaddq_f32(rarea, other), inter);
+        const uint32x4_t over = vcgtq_f32(vdivq_f32(inter, vaddq_f32(denom, eps)), thr);
+
+        if (vmaxvq_u32(over) == 0) continue;
+
+        suppressed[j + 0] |= vgetq_lane_u32(over, 0) & 1;
+        suppressed[j + 1] |= vgetq_lane_u32(over, 1) & 1;
+        suppressed[j + 2] |= vgetq_lane_u32(over, 2) & 1;
+        suppressed[j + 3] |= vgetq_lane_u32(over, 3) & 1;
+    }
+#elif defined(YOLO_SIMD_SSE2)
+    const __m128 rx1 = _mm_set1_ps(x1[ref]), ry1 = _mm_set1_ps(y1[ref]);
+    const __m128 rx2 = _mm_set1_ps(x2[ref]), ry2 = _mm_set1_ps(y2[ref]);
+    const __m128 rarea = _mm_set1_ps(area[ref]);
+    const __m128 zero = _mm_setzero_ps(), eps = _mm_set1_ps(1e-6f), thr = _mm_set1_ps(threshold);
+
+    for (; j + 4 <= end; j += 4) {
+        const __m128 w = _mm_max_ps(zero, _mm_sub_ps(_mm_min_ps(rx2, _mm_loadu_ps(x2 + j)), _mm_max_ps(rx1, _mm_loadu_ps(x1 + j))));
+        const __m128 h = _mm_max_ps(zero, _mm_sub_ps(_mm_min_ps(ry2, _mm_loadu_ps(y2 + j)), _mm_max_ps(ry1, _mm_loadu_ps(y1 + j))));
+        const __m128 inter = _mm_mul_ps(w, h);
+        const __m128 other = _mm_loadu_ps(area + j);
+        const __m128 denom = over_smaller ? _mm_min_ps(rarea, other) : _mm_sub_ps(_mm_add_ps(rarea, other), inter);
+        int bits = _mm_movemask_ps(_mm_cmpgt_ps(_mm_div_ps(inter, _mm_add_ps(denom, eps)), thr));
+
+        while (bits) {
+            suppressed[j + __builtin_ctz(bits)] = 1;
+            bits &= bits - 1;
+        }
+    }
+#endif
+
+    for (; j < end; ++j) {
+        const float w = std::max(0.0f, std::min(x2[ref], x2[j]) - std::max(x1[ref], x1[j]));
+        const float h = std::max(0.0f, std::min(y2[ref], y2[j]) - std::max(y1[ref], y1[j]));
+        const float inter = w * h;
+        const float denom = over_smaller ? std::min(area[ref], area[j]) : area[ref] + area[j] - inter;
+
+        if (inter / (denom + 1e-6f) > threshold) suppressed[j] = 1;
+    }
+}
@@ -2,12 +2,10 @@
 #include <iostream>
 #include <fstream>
 #include <filesystem>
-
-// System Library
-#include <unistd.h>
-#include <fcntl.h>
-#include <sys/inotify.h>
-#include <sys/time.h>
+#include <sstream>
+#include <iterator>
+#include <map>
+#include <cstdlib>
 
 // MQTT
 #include <mqtt/async_client.h>
@@ -20,14 +18,20 @@
 #include "fall_detector.h"
 #include "crowd_detector.h"
 #include "congestion_analyzer.h"
+#include "congestion_model.h"
 #include "path_finder.h"
 #include "renderer.h"
 #include "speaker.h"
+#include "inference_executor.h"
+#include "capture_watcher.h"
+#include "ftp_ingest_server.h"
+#include "archive_writer.h"
+#include "jpeg_codec.h"
+#include "incident_controller.h"
+#include "tracer.h"
+#include "replay_driver.h"
 #include "config.h"
 
-#define EVENT_SIZE       (sizeof(struct inotify_event))
-#define EVENT_BUF_LEN    (1024 * (EVENT_SIZE + 16))
-
 using json = nlohmann::json;
 namespace fs = std::filesystem;
 
@@ -39,75 +43,72 @@ const std::string mqtt_topic_capture_request = "main/data/cap";
 const std::string mqtt_topic_periodic_receive = "pi/data/Count";
 const std::string mqtt_topic_periodic_send = "main/data/Count";
 const std::string mqtt_topic_off_order_from_qt = "qt/off";
+const std::string mqtt_topic_trace_diag = "main/diag/trace";
 const std::vector<std::string> sub_camera_ids = { "1", "2", "3" };
 const std::string mqtt_client_id = "main_pi";
 const std::string mqtt_cert_path = "/usr/local/share/ca-certificates/ca.crt";
 
-// Global state
-int fall_center_x = -1, fall_center_y = -1;
-std::vector<int> sub_camera_crowd_counts = { -1, -1, -1 };
-std::vector<int> congestion_grid_counts;
-int congestion_grid_rows, congestion_grid_cols;
-int image_width = 0, image_height = 0;
-
-std::atomic<bool> fall_event_response_enabled(true);
-std::atomic<bool> periodic_event_response_enabled(true);
-std::atomic<bool> off_order_from_qt(false);
-std::atomic<unsigned long> fall_event_start_time(0);
-std::atomic<unsigned long> gate_led_turn_on_time(0);
+// Capture directory and filename rules
+const std::string capture_directory = "./cap_repo";
+const std::string fall_capture_rule = "EventRule_1-CH1";
+const std::string periodic_capture_rule = "EventRule_2-CH1";
+const std::chrono::milliseconds capture_deadline(CAPTURE_TIMEOUT_MS);
+const char* const ftp_user_variable = "CAPTURE_FTP_USER";          // Login the CH1 camera's FTP upload is configured with
+const char* const ftp_password_variable = "CAPTURE_FTP_PASSWORD";
 
-std::mutex state_mutex;
-std::condition_variable main_camera_condition;
+// Executor statistics print interval
+const std::chrono::milliseconds executor_stats_interval(60000);
+const std::chrono::milliseconds trace_dump_interval(TRACE_DUMP_INTERVAL_MS);
 
-std::string fall_event_timestamp;
-fs::path capture_result_folder = "./";
-
-cv::Mat crowd_incident_image;
-std::vector<cv::Point> detected_people_coordinates;
-
-bool gate_led_is_on = false;
+// Replay: how often the loop checks whether the timeline is played and drained
+const std::chrono::milliseconds replay_check_interval(100);
 
+// Global state (the fall cycle itself lives in the IncidentController)
 std::vector<Exit> dynamic_exit_points;
+uint64_t exit_layout_version = 0;  // Bumped on every exit update; guarded by exit_mutex
 std::mutex exit_mutex;
 
-std::atomic<bool> crowd_result_expected(false);
-
 Speaker global_speaker;
 std::thread speaker_thread;
 
-std::chrono::steady_clock::time_point g_t_mqtt_fall_triggered;
-std::chrono::steady_clock::time_point g_t_ch1_detected;
-std::chrono::steady_clock::time_point g_t_fall_done;
-std::chrono::steady_clock::time_point g_t_subcrowd_done;
-std::chrono::steady_clock::time_point g_t_congestion_done;
-std::chrono::steady_clock::time_point g_t_path_done;
-std::chrono::steady_clock::time_point g_t_visual_done;
-std::chrono::steady_clock::time_point g_t_publish_done;
+ArchiveWriter global_archive_writer;
 
-unsigned long millis();
+CongestionModel global_congestion_model;  // Fed by every CH1 detection, periodic and fall; read by routing
+std::map<std::string, std::vector<ArchiveTiming>> archive_timings;  // Per event timestamp; touched only on the archive writer thread
 
 void periodicPublishThread(mqtt::async_client* _mqtt_client, std::atomic<bool>& _running_flag);
-void waitAndProcessNew1jpg(const std::string& _watch_directory, int _timeout_sec, int _poll_interval_ms, FallDetector& _fall_detector);
-void findFallOnCH1(const cv::Mat& _image, FallDetector& _fall_detector);
+void processFallCapture(uint64_t _incident_id, const std::string& _event_timestamp, CaptureFrame _frame, FallDetector& _fall_detector, IncidentEventQueue* _incident_events);
+FallAnalysis findFallOnCH1(const cv::Mat& _image, FallDetector& _fall_detector, const fs::path& _result_folder);
 void safeMoveImage(const std::string& _source_path, const std::string& _destination_dir);
-void crowdCountingSub(mqtt::async_client* _mqtt_client, int _people_count, std::size_t _camera_index);
-void controlGateLed(mqtt::async_client* _mqtt_client, const cv::Mat& _incident_image, const std::vector<cv::Point>& _people_coordinates);
-void saveFallLog(mqtt::async_client* _mqtt_client, const std::string& _event_timestamp, int _fall_x, int _fall_y, int _selected_gate_index);
+RouteCandidates computeRouteCandidates(const FallAnalysis& _analysis);
+RoutePlan planEvacuationRoute(const Incident& _incident);
+void controlGateLed(mqtt::async_client* _mqtt_client, Incident& _incident);
+void turnOffGateLed(mqtt::async_client* _mqtt_client, int _gate_index);
+void saveFallLog(mqtt::async_client* _mqtt_client, const Incident& _incident, bool _rerouted = false);
+void publishIncidentError(mqtt::async_client* _mqtt_client, const std::string& _event_timestamp, const std::string& _payload);
+void publishTraceReport(mqtt::async_client* _mqtt_client);
 void clearCaptureRepoDirectory(const std::string& directory_path);
 
-void waitAndProcessPeriodicjpg(const std::string& _watch_directory, int _timeout_sec, int _poll_interval_ms, FallDetector& _fall_detector, mqtt::async_client* mqtt_client_);
-void crowdCountingPeriodic(const cv::Mat& _image, FallDetector& _fall_detector, mqtt::async_client* mqtt_client_);
+void processPeriodicCapture(CaptureFrame _frame, FallDetector& _fall_detector, mqtt::async_client* mqtt_client_);
+cv::Mat decodeCapture(const CaptureFrame& _frame, int _target_long_side = 0, cv::Size* _full_size = nullptr);
+std::string extractEventTimestamp(const std::string& _filename);
+ArchiveCallback archiveTimingRecorder(const std::string& _event_timestamp);
+void releaseArchive(const std::string& _event_timestamp);
+void registerCaptureHandlers(CaptureWatcher& _capture_watcher, InferenceExecutor& _inference_executor, FallDetector& _fall_detector, mqtt::async_client* _mqtt_client, IncidentEventQueue* _incident_events);
+std::vector<cv::Point> crowdCountingPeriodic(const cv::Mat& _image, FallDetector& _fall_detector, mqtt::async_client* mqtt_client_);
 void safeDeleteImage(const std::string& _source_path);
+bool parseCommandLine(int _argc, char* _argv[], ModelPrecision& _fall_precision, ModelPrecision& _crowd_precision,
+    std::string& _replay_directory, double& _replay_speed);
+bool runReplay(const std::string& _replay_directory, double _replay_speed, CaptureWatcher& _capture_watcher, mqtt::callback& _main_callback,
+    IncidentController& _incident_controller, InferenceExecutor& _inference_executor, ReplayMqttClient& _replay_client);
 
 class MainCallback : public virtual mqtt::callback
 {
 public:
-    MainCallback(FallDetector* _fall_detector,
-        CrowdDetector* _crowd_detector,
-        mqtt::async_client* _mqtt_client)
-        : fall_detector_instance_(_fall_detector),
-        crowd_detector_instance_(_crowd_detector),
-        mqtt_client_(_mqtt_client)
+    MainCallback(mqtt::async_client* _mqtt_client,
+        IncidentEventQueue* _incident_events)
+        : mqtt_client_(_mqtt_client),
+        incident_events_(_incident_events)
     {
     }
 
@@ -115,39 +116,12 @@ public:
     {
         std::string topic = _message->get_topic();
 
+        // Fall-cycle messages only become events; the IncidentController applies them in order
         if (topic == mqtt_topic_fall_trigger)
         {
-            if (!fall_event_response_enabled)
-            {
-                std::cout << "[EVENT] Ignored fall trigger: waiting for LED timeout reset" << std::endl;
-                return;
-            }
-
-            fall_event_response_enabled = false;
-            fall_event_start_time = millis();
-            crowd_result_expected = true;
-
-            {
-                std::lock_guard<std::mutex> lock(state_mutex);
-                sub_camera_crowd_counts = { -1, -1, -1 };
-            }
-
-            std::cout << "[EVENT] Fall event triggered via MQTT" << std::endl;
-
-            g_t_mqtt_fall_triggered = std::chrono::steady_clock::now();
-
-            auto request_message = mqtt::make_message(mqtt_topic_capture_request, "");
-            request_message->set_qos(1);
-            mqtt_client_->publish(request_message);
-            std::cout << "[MQTT] Published capture request: " << mqtt_topic_capture_request << std::endl;
-
-            std::thread(
-                waitAndProcessNew1jpg,
-                "./cap_repo",
-                60,
-                500,
-                std::ref(*fall_detector_instance_)
-            ).detach();
+            IncidentEvent event;
+            event.type = IncidentEventType::FallTrigger;
+            incident_events_->push(std::move(event));
         }
         else if (topic == mqtt_topic_exit_info)
         {
@@ -182,6 +156,7 @@ public:
                 {
                     std::lock_guard<std::mutex> lock(exit_mutex);
                     dynamic_exit_points = parsed_exits;
+                    ++exit_layout_version;
                     std::cout << "[EXITS] Updated camera points (count: " << dynamic_exit_points.size() << ")" << std::endl;
                 }
                 else
@@ -202,57 +177,269 @@ public:
 
             std::cout << "[MQTT] Received sub-camera (" << sub_camera_id << ") crowd count: " << payload << std::endl;
 
-            int camera_index = std::stoi(sub_camera_id);
-            int people_count = std::stoi(payload);
-
-            crowdCountingSub(mqtt_client_, people_count, camera_index);
+            // "<count> <incident id>"; sub servers that predate the id send the count alone
+            std::istringstream fields(payload);
+            int count = -1;
+            uint64_t incident_id = 0;
+            if (!(fields >> count) || count < 0)
+            {
+                std::cerr << "[CROWD] Invalid count from sub-camera " << sub_camera_id << ": " << payload << std::endl;
+                return;
+            }
+            fields >> incident_id;
+
+            IncidentEvent event;
+            event.type = IncidentEventType::SubCount;
+            event.camera_index = std::strtoul(sub_camera_id.c_str(), nullptr, 10);
+            event.count = count;
+            event.incident_id = incident_id;
+            incident_events_->push(std::move(event));
         }
         else if (topic == mqtt_topic_periodic_receive)
         {
-            if (!periodic_event_response_enabled)
+            IncidentEvent event;
+            event.type = IncidentEventType::PeriodicTrigger;
+            incident_events_->push(std::move(event));
+        }
+        else if (topic == mqtt_topic_off_order_from_qt)
+        {
+            IncidentEvent event;
+            event.type = IncidentEventType::OffOrder;
+            incident_events_->push(std::move(event));
+        }
+    }
+
+private:
+    mqtt::async_client* mqtt_client_;
+    IncidentEventQueue* incident_events_;
+};
+
+class MainIncidentActions : public IncidentActions
+{
+public:
+    MainIncidentActions(mqtt::async_client* _mqtt_client,
+        CaptureWatcher* _capture_watcher,
+        InferenceExecutor* _inference_executor,
+        FallDetector* _fall_detector,
+        IncidentEventQueue* _incident_events)
+        : mqtt_client_(_mqtt_client),
+        capture_watcher_(_capture_watcher),
+        inference_executor_(_inference_executor),
+        fall_detector_(_fall_detector),
+        incident_events_(_incident_events)
+    {
+    }
+
+    void requestCapture(const Incident& _incident) override
+    {
+        try
+        {
+            // The sub-cameras echo the incident id with their counts
+            auto request_message = mqtt::make_message(mqtt_topic_capture_request, std::to_string(_incident.id));
+            request_message->set_qos(1);
+            mqtt_client_->publish(request_message);
+            std::cout << "[MQTT] Published capture request: " << mqtt_topic_capture_request << std::endl;
+        }
+        catch (const mqtt::exception& ex)
+        {
+            std::cerr << "[MQTT ERROR] Failed to publish capture request: " << ex.what() << std::endl;
+        }
+
+        // One pending capture per open incident
+        capture_watcher_->disarm(periodic_capture_rule);
+        capture_watcher_->arm(fall_capture_rule, _incident.id);
+    }
+
+    void armPeriodicCapture() override
+    {
+        capture_watcher_->arm(periodic_capture_rule);
+    }
+
+    bool analyzeCapture(const Incident& _incident, CaptureFrame _frame) override
+    {
+        // Archive writes wait until the LED command and results of every open incident are out
+        global_archive_writer.hold();
+
+        const uint64_t incident_id = _incident.id;
+        const std::string event_timestamp = _incident.timestamp;
+        FallDetector* fall_detector = fall_detector_;
+        IncidentEventQueue* incident_events = incident_events_;
+
+        return inference_executor_->submit(JobClass::Fall,
+            [incident_id, event_timestamp, frame = std::move(_frame), fall_detector, incident_events]() mutable {
+                processFallCapture(incident_id, event_timestamp, std::move(frame), *fall_detector, incident_events);
+            });
+    }
+
+    bool planRoute(const Incident& _incident) override
+    {
+        IncidentEventQueue* incident_events = incident_events_;
+
+        // The job plans on its own copy; the controller keeps taking events meanwhile
+        return inference_executor_->submit(JobClass::Fall, [snapshot = _incident, incident_events]() {
+            IncidentEvent event;
+            event.type = IncidentEventType::Routed;
+            event.incident_id = snapshot.id;
+
+            // A failed plan (ok = false) still reaches the controller, which reports it and resets the incident
+            try
             {
-                //std::cout << "[EVENT] Ignored fall trigger: waiting for LED timeout reset" << std::endl;
-                return;
+                event.plan = planEvacuationRoute(snapshot);
+            }
+            catch (const std::exception& ex)
+            {
+                std::cerr << "[PATH ERROR] Route planning of incident #" << snapshot.id << " failed: " << ex.what() << std::endl;
+                event.plan = RoutePlan();
             }
-            std::thread(
-                waitAndProcessPeriodicjpg,
-                "./cap_repo",
-                60,
-                500,
-                std::ref(*fall_detector_instance_),
-                mqtt_client_
-            ).detach();
+
+            incident_events->push(std::move(event));
+            });
+    }
+
+    void publish(Incident& _incident) override
+    {
+        if (!_incident.plan.ok)
+        {
+            publishIncidentError(mqtt_client_, _incident.timestamp, "Pathfinding failed: no path found to exits.");
+            return;
         }
-        else if (topic == mqtt_topic_off_order_from_qt)
+
+        TraceSpan span(TraceStage::Publish);
+        controlGateLed(mqtt_client_, _incident);
+        saveFallLog(mqtt_client_, _incident);
+    }
+
+    void republish(Incident& _incident) override
+    {
+        controlGateLed(mqtt_client_, _incident);
+        saveFallLog(mqtt_client_, _incident, true);
+    }
+
+    void turnOffGateLed(int _gate_index) override
+    {
+        ::turnOffGateLed(mqtt_client_, _gate_index);
+    }
+
+    void reset(const Incident& _incident, const char*) override
+    {
+        // Only a Triggered incident still has a capture pending
+        if (_incident.state == IncidentState::Triggered)
         {
-            off_order_from_qt = true;
+            capture_watcher_->disarm(fall_capture_rule, _incident.id);
+            return;
         }
+
+        // The writer is held from the capture on; the first publish already released it
+        if (_incident.published_gate < 0)
+            releaseArchive(_incident.timestamp);
     }
 
 private:
-    FallDetector* fall_detector_instance_;
-    CrowdDetector* crowd_detector_instance_;
     mqtt::async_client* mqtt_client_;
+    CaptureWatcher* capture_watcher_;
+    InferenceExecutor* inference_executor_;
+    FallDetector* fall_detector_;
+    IncidentEventQueue* incident_events_;
 };
 
-int main()
+int main(int argc, char* argv[])
 {
-    FallDetector fall_detector(FALL_MODEL_PATH);
-    CrowdDetector crowd_detector(CROWD_MODEL_PATH);
+    ModelPrecision fall_precision = FALL_MODEL_PRECISION;
+    ModelPrecision crowd_precision = CROWD_MODEL_PRECISION;
+    std::string replay_directory;
+    double replay_speed = 1.0;
 
-    if (!global_speaker.init()) {
-        std::cerr << "[SPEAKER] Initialization failed." << std::endl;
+    if (!parseCommandLine(argc, argv, fall_precision, crowd_precision, replay_directory, replay_speed))
+    {
+        std::cerr << "Usage: " << argv[0] << " [--fall-precision fp32|fp16|int8] [--crowd-precision fp32|fp16|int8]"
+            << " [--replay <dir> [--replay-speed <x>]]" << std::endl;
         return 1;
     }
-    speaker_thread = std::thread([]() {
-        global_speaker.run();
-        });
+
+    const bool replay_mode = !replay_directory.empty();
+
+    FallDetector fall_detector(FALL_MODEL_PATH, fall_precision);
+    CrowdDetector crowd_detector(CROWD_MODEL_PATH, crowd_precision);
+
+    std::cout << "[INIT] Fall model precision: " << modelPrecisionName(fall_detector.precision())
+        << ", crowd model precision: " << modelPrecisionName(crowd_detector.precision()) << std::endl;
+
+    // Warm-up runs are not latency samples
+    tracer().collect();
+    tracer().reset();
+
+    // A replay plays no audio
+    if (!replay_mode)
+    {
+        if (!global_speaker.init()) {
+            std::cerr << "[SPEAKER] Initialization failed." << std::endl;
+            return 1;
+        }
+        speaker_thread = std::thread([]() {
+            global_speaker.run();
+            });
+    }
 
     mqtt::ssl_options ssl_options;
     ssl_options.set_trust_store(mqtt_cert_path);
 
-    mqtt::async_client mqtt_client(mqtt_broker_address, mqtt_client_id);
-    MainCallback main_callback(&fall_detector, &crowd_detector, &mqtt_client);
+    // Outlives every producer: MQTT callback, capture watcher and inference workers
+    IncidentEventQueue incident_events;
+
+    InferenceExecutor inference_executor(INFERENCE_WORKER_COUNT, INFERENCE_QUEUE_CAPACITY);
+
+    // A replay runs the same pipeline against an in-process stand-in for the broker
+    std::unique_ptr<mqtt::async_client> mqtt_client_owner;
+    ReplayMqttClient* replay_client = nullptr;
+    if (replay_mode)
+    {
+        auto stand_in = std::make_unique<ReplayMqttClient>();
+        replay_client = stand_in.get();
+        mqtt_client_owner = std::move(stand_in);
+    }
+    else
+    {
+        mqtt_client_owner = std::make_unique<mqtt::async_client>(mqtt_broker_address, mqtt_client_id);
+    }
+    mqtt::async_client& mqtt_client = *mqtt_client_owner;
+
+    global_archive_writer.start();
+
+    CaptureWatcher capture_watcher(capture_directory);
+    registerCaptureHandlers(capture_watcher, inference_executor, fall_detector, &mqtt_client, &incident_events);
+    if (!capture_watcher.start())
+    {
+        std::cerr << "[INOTIFY] Capture watcher failed to start." << std::endl;
+        if (speaker_thread.joinable())
+        {
+            global_speaker.requestShutdown();
+            global_speaker.stop();
+            speaker_thread.join();
+        }
+        return 1;
+    }
+
+    // The camera uploads straight into memory when its FTP target is this server instead of the system FTP daemon
+    const char* ftp_user = std::getenv(ftp_user_variable);
+    const char* ftp_password = std::getenv(ftp_password_variable);
+    FtpIngestServer ftp_ingest_server(FTP_INGEST_PORT, capture_directory, ftp_user ? ftp_user : "", ftp_password ? ftp_password : "", capture_watcher);
+    if (replay_mode)
+    {
+        // Captures come from the recording
+    }
+    else if (!ftp_user || !ftp_password)
+    {
+        std::cerr << "[FTP] " << ftp_user_variable << " / " << ftp_password_variable << " not set; captures arrive through the system FTP daemon." << std::endl;
+    }
+    else if (!ftp_ingest_server.start())
+    {
+        std::cerr << "[FTP] Upload receiver unavailable; captures arrive through the system FTP daemon." << std::endl;
+    }
+
+    MainIncidentActions incident_actions(&mqtt_client, &capture_watcher, &inference_executor, &fall_detector, &incident_events);
+    IncidentController incident_controller(incident_events, incident_actions);
+
+    MainCallback main_callback(&mqtt_client, &incident_events);
 
     mqtt::connect_options connect_options = mqtt::connect_options_builder()
         .clean_session(true)
@@ -261,95 +448,192 @@ int main()
         .finalize();
 
     std::atomic<bool> heartbeat_running(true);
+    int exit_code = 0;
     std::thread heartbeat_thread(periodicPublishThread, &mqtt_client, std::ref(heartbeat_running));
 
     try
     {
-        mqtt_client.set_callback(main_callback);
-        mqtt_client.connect(connect_options)->wait();
+        // A replay has no broker: its driver calls the callback itself
+        if (!replay_mode)
+        {
+            mqtt_client.set_callback(main_callback);
+            mqtt_client.connect(connect_options)->wait();
 
-        mqtt_client.subscribe(mqtt_topic_fall_trigger, 1);
-        std::cout << "[MQTT] Subscribed: " << mqtt_topic_fall_trigger << std::endl;
+            mqtt_client.subscribe(mqtt_topic_fall_trigger, 1);
+            std::cout << "[MQTT] Subscribed: " << mqtt_topic_fall_trigger << std::endl;
 
-        mqtt_client.subscribe(mqtt_topic_exit_info, 1);
-        std::cout << "[MQTT] Subscribed: " << mqtt_topic_exit_info << std::endl;
+            mqtt_client.subscribe(mqtt_topic_exit_info, 1);
+            std::cout << "[MQTT] Subscribed: " << mqtt_topic_exit_info << std::endl;
 
-        mqtt_client.subscribe(mqtt_topic_periodic_receive, 1);
-        std::cout << "[MQTT] Subscribed: " << mqtt_topic_periodic_receive << std::endl;
+            mqtt_client.subscribe(mqtt_topic_periodic_receive, 1);
+            std::cout << "[MQTT] Subscribed: " << mqtt_topic_periodic_receive << std::endl;
 
-        for (const auto& sub_id : sub_camera_ids)
-        {
-            std::string topic = "sub/capture/" + sub_id;
-            mqtt_client.subscribe(topic, 1);
-            std::cout << "[MQTT] Subscribed: " << topic << std::endl;
+            mqtt_client.subscribe(mqtt_topic_off_order_from_qt, 1);
+            std::cout << "[MQTT] Subscribed: " << mqtt_topic_off_order_from_qt << std::endl;
+
+            for (const auto& sub_id : sub_camera_ids)
+            {
+                std::string topic = "sub/capture/" + sub_id;
+                mqtt_client.subscribe(topic, 1);
+                std::cout << "[MQTT] Subscribed: " << topic << std::endl;
+            }
         }
 
         std::cout << "[MAIN] System ready. Waiting for fall events..." << std::endl;
 
-        while (true)
-        {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-
-            unsigned long current_time_ms = millis();
-
-            if (gate_led_is_on && current_time_ms - gate_led_turn_on_time >= 60000)
-            {
-                fall_center_x = -1;
-                fall_center_y = -1;
-                gate_led_is_on = false;
-                fall_event_start_time = 0;
-                periodic_event_response_enabled = true;
-                fall_event_response_enabled = true;
-                std::cout << "[TIMEOUT] Auto-reset: LED off, fall detection re-enabled" << std::endl;
-            }
+        incident_controller.timers().scheduleAfter(executor_stats_interval, [&inference_executor, &incident_controller]() {
+            inference_executor.printStats();
+            incident_controller.printStats();
+            }, executor_stats_interval);
 
-            if (!fall_event_response_enabled && fall_event_start_time > 0 &&
-                (current_time_ms - fall_event_start_time >= 60000))
-            {
-                fall_center_x = -1;
-                fall_center_y = -1;
-                periodic_event_response_enabled = true;
-                fall_event_response_enabled = true;
-                fall_event_start_time = 0;
-                std::cout << "[TIMEOUT] No LED response. Fall detection re-enabled after 30s." << std::endl;
-            }
+        incident_controller.timers().scheduleAfter(trace_dump_interval, [&mqtt_client]() {
+            publishTraceReport(&mqtt_client);
+            }, trace_dump_interval);
 
-            if (off_order_from_qt)
+        if (replay_mode)
+        {
+            if (!runReplay(replay_directory, replay_speed, capture_watcher, main_callback, incident_controller, inference_executor, *replay_client))
+                exit_code = 1;
+        }
+        else
+        {
+            // Event loop: sleeps until an event or the next timer (incident timeouts, LED auto-off, statistics)
+            while (true)
             {
-                off_order_from_qt = false;
-                fall_center_x = -1;
-                fall_center_y = -1;
-                gate_led_is_on = false;
-                fall_event_start_time = 0;
-                periodic_event_response_enabled = true;
-                fall_event_response_enabled = true;
-                std::cout << "[TIMEOUT] Qt announced emergency situation is over. Fall detection re-enabled." << std::endl;
+                incident_controller.processEvents();
             }
         }
     }
     catch (const mqtt::exception& ex)
     {
         std::cerr << "[FATAL] MQTT connection error: " << ex.what() << std::endl;
+        ftp_ingest_server.stop();
+        capture_watcher.stop();
+        inference_executor.stop();
+        global_archive_writer.stop();
         heartbeat_running = false;
         if (heartbeat_thread.joinable()) heartbeat_thread.join();
         return 1;
     }
 
+    ftp_ingest_server.stop();
+    capture_watcher.stop();
+    inference_executor.stop();
+    inference_executor.printStats();
+    global_archive_writer.stop();
+
     heartbeat_running = false;
     if (heartbeat_thread.joinable()) heartbeat_thread.join();
 
-    global_speaker.requestShutdown();
-    global_speaker.stop();
-    if (speaker_thread.joinable()) speaker_thread.join();
+    if (speaker_thread.joinable())
+    {
+        global_speaker.requestShutdown();
+        global_speaker.stop();
+        speaker_thread.join();
+    }
 
-    return 0;
+    return exit_code;
 }
 
-unsigned long millis()
+bool parseCommandLine(int _argc, char* _argv[], ModelPrecision& _fall_precision, ModelPrecision& _crowd_precision,
+    std::string& _replay_directory, double& _replay_speed)
 {
-    struct timeval time_value;
-    gettimeofday(&time_value, nullptr);
-    return (time_value.tv_sec * 1000) + (time_value.tv_usec / 1000);
+    for (int i = 1; i < _argc; ++i)
+    {
+        std::string option = _argv[i];
+
+        if ((option == "--fall-precision" || option == "--crowd-precision") && i + 1 < _argc)
+        {
+            ModelPrecision& target = (option == "--fall-precision") ? _fall_precision : _crowd_precision;
+            if (!parseModelPrecision(_argv[++i], target))
+            {
+                std::cerr << "[INIT] Unknown precision: " << _argv[i] << std::endl;
+                return false;
+            }
+        }
+        else if (option == "--replay" && i + 1 < _argc)
+        {
+            _replay_directory = _argv[++i];
+        }
+        else if (option == "--replay-speed" && i + 1 < _argc)
+        {
+            try
+            {
+                _replay_speed = std::stod(_argv[++i]);
+            }
+            catch (const std::exception&)
+            {
+                _replay_speed = -1.0;
+            }
+
+            if (_replay_speed < 0.0)
+            {
+                std::cerr << "[INIT] Invalid replay speed: " << _argv[i] << std::endl;
+                return false;
+            }
+        }
+        else
+        {
+            std::cerr << "[INIT] Unknown option: " << option << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool runReplay(const std::string& _replay_directory, double _replay_speed, CaptureWatcher& _capture_watcher, mqtt::callback& _main_callback,
+    IncidentController& _incident_controller, InferenceExecutor& _inference_executor, ReplayMqttClient& _replay_client)
+{
+    ReplayDriver replay_driver(_replay_directory, _capture_watcher, _main_callback, _replay_speed);
+    if (!replay_driver.load()) return false;
+
+    // Incidents still open after the last event get until their own timeouts to close
+    const std::chrono::milliseconds drain_timeout(INCIDENT_TIMEOUT_MS + SUB_COUNT_LATE_WINDOW_MS);
+    auto drain_deadline = std::chrono::steady_clock::time_point::max();
+    bool replay_done = false;
+
+    const TimerId check_timer = _incident_controller.timers().scheduleAfter(replay_check_interval, [&]() {
+        if (!replay_driver.finished()) return;
+
+        const auto now = std::chrono::steady_clock::now();
+        if (drain_deadline == std::chrono::steady_clock::time_point::max()) drain_deadline = now + drain_timeout;
+
+        replay_done = _incident_controller.openIncidents().empty() || now >= drain_deadline;
+        }, replay_check_interval);
+
+    std::cout << "[REPLAY] Playing " << _replay_directory << " at "
+        << (_replay_speed > 0.0 ? std::to_string(_replay_speed) + "x" : std::string("full speed")) << std::endl;
+
+    const auto replay_started = std::chrono::steady_clock::now();
+    replay_driver.start();
+
+    while (!replay_done)
+    {
+        _incident_controller.processEvents();
+    }
+
+    const float elapsed_s = std::chrono::duration<float>(std::chrono::steady_clock::now() - replay_started).count();
+    _incident_controller.timers().cancel(check_timer);
+    replay_driver.stop();
+
+    const IncidentStats& stats = _incident_controller.stats();
+    std::cout << "[REPLAY] " << replay_driver.delivered() << "/" << replay_driver.size() << " events in " << elapsed_s
+        << " s (timeline " << replay_driver.duration().count() / 1000.0f << " s), " << stats.published << " incidents published ("
+        << (elapsed_s > 0.0f ? stats.published / elapsed_s : 0.0f) << "/s), " << replay_driver.unclaimed() << " images unclaimed" << std::endl;
+
+    _incident_controller.printStats();
+    _inference_executor.printStats();
+    _replay_client.printSummary();
+
+    // Stage latency distributions of this run, next to the recording
+    tracer().collect();
+    const std::string report_path = (fs::path(_replay_directory) / "replay_trace.json").string();
+    std::cout << "[REPLAY] Stage latencies: " << tracer().report("replay") << std::endl;
+    if (!tracer().dumpToFile(report_path, "replay"))
+        std::cerr << "[REPLAY] Failed to write " << report_path << std::endl;
+
+    return true;
 }
 
 void periodicPublishThread(mqtt::async_client* _mqtt_client, std::atomic<bool>& _running_flag)
@@ -372,195 +656,176 @@ void periodicPublishThread(mqtt::async_client* _mqtt_client, std::atomic<bool>&
     }
 }
 
-void waitAndProcessNew1jpg(const std::string& _watch_directory,
-    int _timeout_sec,
-    int _poll_interval_ms,
-    FallDetector& _fall_detector)
+cv::Mat decodeCapture(const CaptureFrame& _frame, int _target_long_side, cv::Size* _full_size)
 {
-    periodic_event_response_enabled = false;
-    int fd = inotify_init1(IN_NONBLOCK);
-    if (fd < 0)
+    // Frames received by the FTP receiver never touch the disk before inference
+    std::vector<unsigned char> file_data;
+    if (_frame.data.empty())
     {
-        std::cerr << "[INOTIFY] Failed to initialize inotify." << std::endl;
-        return;
+        std::ifstream input(_frame.path, std::ios::binary);
+        file_data.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
     }
+    const std::vector<unsigned char>& data = _frame.data.empty() ? file_data : _frame.data;
+
+    TraceSpan span(TraceStage::Decode);
 
-    int wd = inotify_add_watch(fd, _watch_directory.c_str(), IN_CREATE);
-    if (wd < 0)
+    // With a target size, decode straight at 1/2, 1/4 or 1/8 scale in the DCT domain
+    int scale_denom = 1;
+    cv::Size full_size;
+    if (JPEG_SCALED_DECODE && _target_long_side > 0)
     {
-        std::cerr << "[INOTIFY] Failed to add watch on directory: " << _watch_directory << std::endl;
-        close(fd);
-        return;
+        full_size = jpegImageSize(data.data(), data.size());
+        scale_denom = jpegScaleForTarget(full_size, _target_long_side);
+    }
+
+    cv::Mat image = jpegCodec().decode(data, scale_denom);
+    if (_full_size) *_full_size = (scale_denom > 1 && !full_size.empty()) ? full_size : image.size();
+
+    return image;
+}
+
+void processFallCapture(uint64_t _incident_id, const std::string& _event_timestamp, CaptureFrame _frame, FallDetector& _fall_detector, IncidentEventQueue* _incident_events)
+{
+    const std::string& filename = _frame.name;
+
+    std::cout << "[MONITOR] Detected new EventRule_1-CH1 image: " << (_frame.path.empty() ? "(ingest) " + filename : _frame.path) << std::endl;
+
+    const fs::path capture_result_folder = "./prev_cap_repo/" + _event_timestamp;
+
+    try
+    {
+        if (fs::create_directory(capture_result_folder))
+            std::cout << "[FS] Created folder: " << capture_result_folder << std::endl;
+        else
+            std::cout << "[FS] Folder already exists or failed to create: " << capture_result_folder << std::endl;
+    }
+    catch (const fs::filesystem_error& ex)
+    {
+        std::cerr << "[FS ERROR] Failed to create folder: " << ex.what() << std::endl;
     }
 
-    char buffer[EVENT_BUF_LEN];
-    auto start_time = std::chrono::steady_clock::now();
+    IncidentEvent result;
+    result.type = IncidentEventType::FallAnalyzed;
+    result.incident_id = _incident_id;
 
-    while (true)
+    // The incident waits for this event (holding the archive writer), so it is pushed whatever happens
+    try
     {
-        int length = read(fd, buffer, EVENT_BUF_LEN);
-        if (length < 0)
+        cv::Mat image = decodeCapture(_frame);
+        if (image.empty())
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(_poll_interval_ms));
+            std::cerr << "[MONITOR] Failed to read image: " << filename << std::endl;
         }
         else
         {
-            int i = 0;
-            while (i < length)
-            {
-                struct inotify_event* event = (struct inotify_event*)&buffer[i];
-                if ((event->mask & IN_CREATE) && event->len > 0)
-                {
-                    std::string filename(event->name);
-                    if (filename.find("EventRule_1-CH1") != std::string::npos)
-                    {
-                        std::string image_path = _watch_directory + "/" + filename;
-
-                        unsigned long arrival_time = millis();
-                        unsigned long elapsed = arrival_time - fall_event_start_time;
-                        std::cout << "[PERF] Time from fall trigger to EventRule_1-CH1 image arrival: " << elapsed << " ms" << std::endl;
-
-                        std::cout << "[MONITOR] Detected new EventRule_1-CH1 image: " << image_path << std::endl;
-
-                        size_t pos = filename.find("-EventRule_1-CH1");
-                        if (pos != std::string::npos)
-                            fall_event_timestamp = filename.substr(0, pos);
-                        else
-                        {
-                            fall_event_timestamp = "unknown";
-                            std::cerr << "[WARN] Failed to extract timestamp from filename: " << filename << std::endl;
-                        }
-
-                        capture_result_folder = "./prev_cap_repo/" + fall_event_timestamp;
-
-                        try
-                        {
-                            if (fs::create_directory(capture_result_folder))
-                                std::cout << "[FS] Created folder: " << capture_result_folder << std::endl;
-                            else
-                                std::cout << "[FS] Folder already exists or failed to create: " << capture_result_folder << std::endl;
-                        }
-                        catch (const fs::filesystem_error& ex)
-                        {
-                            std::cerr << "[FS ERROR] Failed to create folder: " << ex.what() << std::endl;
-                        }
-
-                        cv::Mat image = cv::imread(image_path);
-                        if (image.empty())
-                        {
-                            std::cerr << "[MONITOR] Failed to read image: " << image_path << std::endl;
-                            break;
-                        }
-
-                        g_t_ch1_detected = std::chrono::steady_clock::now();
-
-                        {
-                            std::lock_guard<std::mutex> lock(state_mutex);
-                            image_width = image.cols;
-                            image_height = image.rows;
-                            congestion_grid_cols = (image_width + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE;
-                            congestion_grid_rows = (image_height + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE;
-                            std::cout << "[INIT] Resolution set: " << image_width << "x" << image_height << std::endl;
-                        }
-
-                        findFallOnCH1(image, _fall_detector);
-                        g_t_fall_done = std::chrono::steady_clock::now();
-
-                        safeMoveImage(image_path, capture_result_folder.string());
-
-                        inotify_rm_watch(fd, wd);
-                        close(fd);
-                        return;
-                    }
-                }
-                i += sizeof(struct inotify_event) + event->len;
-            }
-        }
+            result.analysis = findFallOnCH1(image, _fall_detector, capture_result_folder);
+            result.analysis.analyzed_at = std::chrono::steady_clock::now();
 
-        if (std::chrono::steady_clock::now() - start_time > std::chrono::seconds(_timeout_sec))
-        {
-            std::cerr << "[TIMEOUT] No new CH1 image received within timeout." << std::endl;
-            break;
+            // The fall frame is the newest observation; routing reads it blended with the periodic ones
+            global_congestion_model.update(image.size(), result.analysis.people, result.analysis.analyzed_at);
+
+            // Speculative: everything but the final scores, while the sub-camera counts are on their way
+            if (result.analysis.fall_detected) result.candidates = computeRouteCandidates(result.analysis);
         }
     }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "[MONITOR ERROR] Fall analysis of incident #" << _incident_id << " failed: " << ex.what() << std::endl;
+        result.analysis = FallAnalysis();
+        result.candidates = RouteCandidates();
+    }
 
-    inotify_rm_watch(fd, wd);
-    close(fd);
+    _incident_events->push(std::move(result));
 
+    if (_frame.path.empty())
+        global_archive_writer.enqueue((capture_result_folder / filename).string(), std::move(_frame.data), archiveTimingRecorder(_event_timestamp));
+    else
+        safeMoveImage(_frame.path, capture_result_folder.string());
 }
 
-void waitAndProcessPeriodicjpg(const std::string& _watch_directory,
-    int _timeout_sec,
-    int _poll_interval_ms,
-    FallDetector& _fall_detector,
-    mqtt::async_client* mqtt_client_)
+std::string extractEventTimestamp(const std::string& _filename)
 {
-    int fd = inotify_init1(IN_NONBLOCK);
-    if (fd < 0)
-    {
-        std::cerr << "[INOTIFY] Failed to initialize inotify." << std::endl;
-        return;
-    }
+    size_t pos = _filename.find("-" + fall_capture_rule);
+    if (pos != std::string::npos) return _filename.substr(0, pos);
 
-    int wd = inotify_add_watch(fd, _watch_directory.c_str(), IN_CREATE);
-    if (wd < 0)
-    {
-        std::cerr << "[INOTIFY] Failed to add watch on directory: " << _watch_directory << std::endl;
-        close(fd);
-        return;
-    }
+    std::cerr << "[WARN] Failed to extract timestamp from filename: " << _filename << std::endl;
+    return "unknown";
+}
 
-    char buffer[EVENT_BUF_LEN];
-    auto start_time = std::chrono::steady_clock::now();
+ArchiveCallback archiveTimingRecorder(const std::string& _event_timestamp)
+{
+    return [_event_timestamp](const ArchiveTiming& timing) {
+        archive_timings[_event_timestamp].push_back(timing);
+        };
+}
 
-    while (true)
-    {
-        int length = read(fd, buffer, EVENT_BUF_LEN);
-        if (length < 0)
-        {
-            std::this_thread::sleep_for(std::chrono::milliseconds(_poll_interval_ms));
-        }
-        else
-        {
-            int i = 0;
-            while (i < length)
-            {
-                struct inotify_event* event = (struct inotify_event*)&buffer[i];
-                if ((event->mask & IN_CREATE) && event->len > 0)
-                {
-                    std::string filename(event->name);
-                    if (filename.find("EventRule_2-CH1") != std::string::npos)
-                    {
-                        std::string image_path = _watch_directory + "/" + filename;
+void releaseArchive(const std::string& _event_timestamp)
+{
+    // Incident ended without a summary: drop its timings once its writes are done
+    global_archive_writer.enqueueTask([_event_timestamp]() {
+        archive_timings.erase(_event_timestamp);
+        });
+    global_archive_writer.release();
+}
 
-                        cv::Mat image = cv::imread(image_path);
-                        if (image.empty())
-                        {
-                            std::cerr << "[MONITOR] Failed to read image: " << image_path << std::endl;
-                            break;
-                        }
+void processPeriodicCapture(CaptureFrame _frame, FallDetector& _fall_detector, mqtt::async_client* mqtt_client_)
+{
+    TraceSpan span(TraceStage::PeopleCount);
+    const auto observed_at = std::chrono::steady_clock::now();
 
-                        crowdCountingPeriodic(image, _fall_detector, mqtt_client_);
-                        safeDeleteImage(image_path);
+    // Only counts and positions are needed, so the detector input size is all the decode needs
+    cv::Size full_size;
+    cv::Mat image = decodeCapture(_frame, FALL_TILED_INFERENCE ? 0 : YOLO_INPUT_WIDTH, &full_size);
+    if (image.empty())
+    {
+        std::cerr << "[MONITOR] Failed to read image: " << _frame.name << std::endl;
+        return;
+    }
 
-                        inotify_rm_watch(fd, wd);
-                        close(fd);
-                        return;
-                    }
-                }
-                i += sizeof(struct inotify_event) + event->len;
-            }
-        }
+    std::vector<cv::Point> people = crowdCountingPeriodic(image, _fall_detector, mqtt_client_);
+    if (!_frame.path.empty()) safeDeleteImage(_frame.path);
 
-        if (std::chrono::steady_clock::now() - start_time > std::chrono::seconds(_timeout_sec))
+    // Positions of a reduced decode back to capture pixels, where the fall frame is analyzed
+    if (full_size != image.size())
+    {
+        const double scale_x = static_cast<double>(full_size.width) / image.cols;
+        const double scale_y = static_cast<double>(full_size.height) / image.rows;
+        for (auto& person : people)
         {
-            std::cerr << "[TIMEOUT] No new CH1 image received within timeout." << std::endl;
-            break;
+            person = cv::Point(static_cast<int>(person.x * scale_x), static_cast<int>(person.y * scale_y));
         }
     }
 
-    inotify_rm_watch(fd, wd);
-    close(fd);
+    global_congestion_model.update(full_size, people, observed_at);
+}
+
+void registerCaptureHandlers(CaptureWatcher& _capture_watcher, InferenceExecutor& _inference_executor,
+    FallDetector& _fall_detector, mqtt::async_client* _mqtt_client, IncidentEventQueue* _incident_events)
+{
+    FallDetector* fall_detector = &_fall_detector;
+    InferenceExecutor* inference_executor = &_inference_executor;
+
+    // The fall rule feeds the incident state machine, which starts the fall job
+    _capture_watcher.addHandler(fall_capture_rule, capture_deadline,
+        [_incident_events](CaptureFrame frame) {
+            IncidentEvent event;
+            event.type = IncidentEventType::Captured;
+            event.timestamp = extractEventTimestamp(frame.name);
+            event.frame = std::move(frame);
+            _incident_events->push(std::move(event));
+        },
+        nullptr,  // Each incident times out its own capture
+        MAX_CONCURRENT_INCIDENTS);
+
+    _capture_watcher.addHandler(periodic_capture_rule, capture_deadline,
+        [inference_executor, fall_detector, _mqtt_client](CaptureFrame frame) {
+            inference_executor->submit(JobClass::Periodic, [frame = std::move(frame), fall_detector, _mqtt_client]() mutable {
+                processPeriodicCapture(std::move(frame), *fall_detector, _mqtt_client);
+                });
+        },
+        []() {
+            std::cerr << "[TIMEOUT] No new periodic CH1 image received within timeout." << std::endl;
+        });
 }
 
 std::mutex file_operation_mutex;
@@ -611,12 +876,14 @@ void safeDeleteImage(const std::string& _source_path)
     }
 }
 
-void findFallOnCH1(const cv::Mat& _image, FallDetector& _fall_detector)
+FallAnalysis findFallOnCH1(const cv::Mat& _image, FallDetector& _fall_detector, const fs::path& _result_folder)
 {
+    FallAnalysis analysis;
+
     if (_image.empty())
     {
         std::cerr << "[FALL] Input image is empty!" << std::endl;
-        return;
+        return analysis;
     }
 
     std::vector<FallInfo> fall_detections = _fall_detector.detect(_image);
@@ -627,20 +894,15 @@ void findFallOnCH1(const cv::Mat& _image, FallDetector& _fall_detector)
         std::cout << "[FALL] No fall candidates detected." << std::endl;
     }
 
-    std::vector<cv::Point> people_coordinates;
-    bool is_fall_detected_flag = false;
     for (const auto& detection : fall_detections)
     {
         if (detection.pred == 0)
         {
-            is_fall_detected_flag = true;
-            {
-                std::lock_guard<std::mutex> lock(state_mutex);
-                fall_center_x = detection.bbox.x + detection.bbox.width / 2;
-                fall_center_y = detection.bbox.y + detection.bbox.height / 2;
-            }
+            analysis.fall_detected = true;
+            analysis.fall_center = cv::Point(detection.bbox.x + detection.bbox.width / 2,
+                detection.bbox.y + detection.bbox.height / 2);
 
-            std::cout << "[FALL] Fall detected at center: (" << fall_center_x << ", " << fall_center_y << ")" << std::endl;
+            std::cout << "[FALL] Fall detected at center: (" << analysis.fall_center.x << ", " << analysis.fall_center.y << ")" << std::endl;
             std::cout << "[FALL] Bounding box: ("
                 << detection.bbox.x << ", " << detection.bbox.y << ") -> ("
                 << detection.bbox.x + detection.bbox.width << ", "
@@ -651,38 +913,43 @@ void findFallOnCH1(const cv::Mat& _image, FallDetector& _fall_detector)
             int person_center_x = detection.bbox.x + detection.bbox.width / 2;
             int person_center_y = detection.bbox.y + detection.bbox.height / 2;
 
-            people_coordinates.push_back(cv::Point(person_center_x, person_center_y));
+            analysis.people.push_back(cv::Point(person_center_x, person_center_y));
         }
     }
 
-    if (!is_fall_detected_flag) {
+    if (!analysis.fall_detected) {
         std::cout << "[FALL] no fall detected." << std::endl;
-        return;
+        return analysis;
     }
 
-    detected_people_coordinates = people_coordinates;
-    crowd_incident_image = _image.clone();
+    analysis.image = _image;  // Not modified after decoding; shared with the routing job
 
-    std::cout << "[CROWD] CH1 crowd detection complete. People count: " << people_coordinates.size() << std::endl;
+    std::cout << "[CROWD] CH1 crowd detection complete. People count: " << analysis.people.size() << std::endl;
 
     Renderer renderer;
     cv::Mat image_copy = _image.clone();
     renderer.drawFallBoxes(image_copy, fall_detections);
 
-    std::string result_path = (capture_result_folder / "result.jpg").string();
-    cv::imwrite(result_path, image_copy);
-    std::cout << "[FALL] Visualized result saved: " << result_path << std::endl;
+    // Encoded and written by the archive writer once the response is out
+    std::string result_path = (_result_folder / "result.jpg").string();
+    global_archive_writer.enqueueImage(result_path, image_copy, archiveTimingRecorder(_result_folder.filename().string()));
+    std::cout << "[FALL] Visualized result queued for saving: " << result_path << std::endl;
+
+    return analysis;
 }
 
-void crowdCountingPeriodic(const cv::Mat& _image, FallDetector& _fall_detector, mqtt::async_client* mqtt_client_)
+std::vector<cv::Point> crowdCountingPeriodic(const cv::Mat& _image, FallDetector& _fall_detector, mqtt::async_client* mqtt_client_)
 {
+    std::vector<cv::Point> people;
+
     if (_image.empty())
     {
         std::cerr << "[CROWD] Input image is empty!" << std::endl;
-        return;
+        return people;
     }
 
-    std::vector<FallInfo> fall_detections = _fall_detector.detect(_image);
+    // The count is published, so it runs at the full input size unless the size policy is enabled for it
+    std::vector<FallInfo> fall_detections = PERIODIC_COUNT_ADAPTIVE_INPUT ? _fall_detector.detectAdaptive(_image) : _fall_detector.detect(_image);
     int people_count = fall_detections.size();
 
     std::string payload = std::to_string(people_count);
@@ -695,75 +962,43 @@ void crowdCountingPeriodic(const cv::Mat& _image, FallDetector& _fall_detector,
     catch (const mqtt::exception& e) {
         std::cerr << "[MQTT ERROR] Publish failed on " << mqtt_topic_periodic_send << ": " << e.what() << std::endl;
     }
-}
-
-void crowdCountingSub(mqtt::async_client* _mqtt_client, int _people_count, std::size_t _camera_index)
-{
-    if (!crowd_result_expected)
-    {
-        std::cout << "[CROWD] Ignored sub-camera crowd count: not expecting results now." << std::endl;
-        return;
-    }
 
-    if (_camera_index < 1 || _camera_index > 3)
+    for (const auto& detection : fall_detections)
     {
-        std::cerr << "[CROWD] Invalid camera index: " << _camera_index << std::endl;
-        return;
+        people.push_back(cv::Point(detection.bbox.x + detection.bbox.width / 2, detection.bbox.y + detection.bbox.height / 2));
     }
 
-    {
-        std::lock_guard<std::mutex> lock(state_mutex);
-        sub_camera_crowd_counts[_camera_index - 1] = _people_count;
-        std::cout << "[CROWD] sub_camera_crowd_counts[" << (_camera_index - 1)
-            << "] = " << _people_count << std::endl;
-    }
+    return people;
+}
 
-    if (fall_center_x >= 0 && fall_center_y >= 0)
-    {
-        bool all_counts_ready = true;
-        for (int i = 0; i < 3; ++i)
-        {
-            if (sub_camera_crowd_counts[i] < 0)
-            {
-                all_counts_ready = false;
-                break;
-            }
-        }
+RouteCandidates computeRouteCandidates(const FallAnalysis& _analysis)
+{
+    RouteCandidates candidates;
 
-        if (all_counts_ready)
-        {
-            g_t_subcrowd_done = std::chrono::steady_clock::now();
+    const int image_width = _analysis.image.cols;
+    const int image_height = _analysis.image.rows;
 
-            controlGateLed(_mqtt_client, crowd_incident_image, detected_people_coordinates);
+    TraceSpan congestion_span(TraceStage::Congestion);
+    CongestionAnalyzer congestion_analyzer(image_width, image_height);
 
-            for (int i = 0; i < 3; ++i)
-            {
-                sub_camera_crowd_counts[i] = -1;
-            }
-        }
+    // Rolling grid over the recent periodic frames and this one; the frame alone if the model is stale
+    Grid<float> congestion_grid = global_congestion_model.snapshot(_analysis.image.size(), std::chrono::steady_clock::now());
+    if (congestion_grid.empty())
+    {
+        std::cout << "[CONTROL] No recent congestion model, using the fall frame only" << std::endl;
+        congestion_grid = congestion_analyzer.analyzeCongestionGrid(_analysis.people);
     }
-}
-
-std::vector<PathInfo> paths_info = {};
-
-void controlGateLed(mqtt::async_client* _mqtt_client,
-    const cv::Mat& _incident_image,
-    const std::vector<cv::Point>& _people_coordinates)
-{
-    if (fall_center_x < 0 || fall_center_y < 0)
+    else
     {
-        std::cerr << "[ERROR] Fall center coordinates are not set." << std::endl;
-        return;
+        congestion_analyzer.loadCongestionGrid(congestion_grid);
     }
+    congestion_span.stop();
 
-    CongestionAnalyzer congestion_analyzer(image_width, image_height);
-    std::vector<std::vector<float>> congestion_grid = congestion_analyzer.analyzeCongestionGrid(_people_coordinates);
-
-    g_t_congestion_done = std::chrono::steady_clock::now();
+    candidates.congestion_done = std::chrono::steady_clock::now();
 
-    std::vector<Exit> exits;
     {
         std::lock_guard<std::mutex> lock(exit_mutex);
+        candidates.exit_version = exit_layout_version;
 
         if (!dynamic_exit_points.empty())
         {
@@ -773,7 +1008,7 @@ void controlGateLed(mqtt::async_client* _mqtt_client,
             {
                 cv::Point grid_pos = toGrid(exit.location);
                 cv::Point corrected_pixel = toPixelCenter(grid_pos);
-                exits.push_back({ corrected_pixel, exit.index });
+                candidates.exits.push_back({ corrected_pixel, exit.index });
             }
         }
         else
@@ -783,7 +1018,7 @@ void controlGateLed(mqtt::async_client* _mqtt_client,
             int max_grid_cols = image_width / GRID_CELL_SIZE;
             int max_grid_rows = image_height / GRID_CELL_SIZE;
 
-            exits = {
+            candidates.exits = {
                             { toPixelCenter(cv::Point(0, 0)), 0 },
                             { toPixelCenter(cv::Point(max_grid_cols - 1, 0)), 1 },
                             { toPixelCenter(cv::Point(0, max_grid_rows - 1)), 2 }
@@ -794,149 +1029,213 @@ void controlGateLed(mqtt::async_client* _mqtt_client,
     Pathfinder pathfinder(image_width, image_height);
     pathfinder.setCongestionMap(congestion_grid);
 
-    cv::Point fall_center_pixel = toPixelCenter(toGrid(cv::Point(fall_center_x, fall_center_y)));
+    candidates.fall_center_pixel = toPixelCenter(toGrid(_analysis.fall_center));
 
-    PathInfo best_path_info = {};
-    best_path_info.score = std::numeric_limits<float>::max();
+    // Path, path cost and inner congestion do not depend on the sub-camera counts; one search covers every exit
+    TraceSpan path_span(TraceStage::PathSearch);
+    candidates.paths = pathfinder.generatePathCandidates(candidates.fall_center_pixel, candidates.exits, congestion_analyzer);
+    path_span.stop();
 
-    for (size_t i = 0; i < exits.size(); ++i)
-    {
-        PathInfo path_info = pathfinder.generatePathInfo(fall_center_pixel, exits.at(i), congestion_analyzer, sub_camera_crowd_counts.at(i));
-        paths_info.push_back(path_info);
+    candidates.path_done = std::chrono::steady_clock::now();
 
-        if (best_path_info.score > path_info.score) best_path_info = path_info;
+    // Everything but the selected path is drawn ahead as well
+    TraceSpan render_span(TraceStage::Render);
+    Renderer renderer;
+    candidates.base_image = _analysis.image.clone();
+    renderer.drawCongestionHeatmap(candidates.base_image, congestion_grid);
+    renderer.drawExits(candidates.base_image, candidates.exits);
+    render_span.stop();
+
+    candidates.visual_done = std::chrono::steady_clock::now();
+    candidates.ok = true;
+
+    return candidates;
+}
+
+RoutePlan planEvacuationRoute(const Incident& _incident)
+{
+    RoutePlan plan;
+
+    RouteCandidates candidates = _incident.candidates;
+    bool exits_changed = false;
+    {
+        std::lock_guard<std::mutex> lock(exit_mutex);
+        exits_changed = candidates.exit_version != exit_layout_version;
     }
 
-    if (best_path_info.path.empty())
+    if (!candidates.ok || exits_changed)
     {
-        std::cerr << "[PATH] No valid path found to any exit." << std::endl;
+        std::cout << "[PATH] Speculative paths " << (candidates.ok ? "stale (exits changed)" : "missing") << ", computing now" << std::endl;
+        candidates = computeRouteCandidates(_incident.analysis);
+    }
 
-        try
-        {
-            std::string err_topic = "main/result/error/" + fall_event_timestamp;
-            std::string err_payload = "Pathfinding failed: no path found to exits.";
-            auto err_msg = mqtt::make_message(err_topic, err_payload);
-            err_msg->set_qos(1);
-            _mqtt_client->publish(err_msg);
-        }
-        catch (...)
-        {
-            std::cerr << "[MQTT ERROR] Failed to publish pathfinding error." << std::endl;
-        }
+    plan.exits = candidates.exits;
+    plan.paths = candidates.paths;
 
-        return;
+    // Received counts, or estimates for sub-cameras that missed the count deadline
+    plan.counts = _incident.route_counts;
+    plan.estimated = _incident.count_estimated;
+
+    // Only the score depends on the counts: O(exits)
+    Pathfinder pathfinder(_incident.analysis.image.cols, _incident.analysis.image.rows);
+
+    const PathInfo* best_path_info = nullptr;
+    for (size_t i = 0; i < plan.paths.size(); ++i)
+    {
+        const int outer_count = i < plan.counts.size() ? plan.counts[i] : 0;
+        pathfinder.scorePathInfo(plan.paths[i], outer_count);
+
+        if (!best_path_info || best_path_info->score > plan.paths[i].score) best_path_info = &plan.paths[i];
     }
 
-    g_t_path_done = std::chrono::steady_clock::now();
+    plan.rescore_done = std::chrono::steady_clock::now();
+
+    if (!best_path_info || best_path_info->path.empty())
+    {
+        std::cerr << "[PATH] No valid path found to any exit." << std::endl;
+        return plan;
+    }
 
     Renderer renderer;
-    cv::Mat visualized_image = _incident_image.clone();
-    renderer.drawCongestionHeatmap(visualized_image, congestion_grid);
-    renderer.drawExits(visualized_image, exits);
-    renderer.drawPath(visualized_image, best_path_info.path, fall_center_pixel, best_path_info.exit);
+    cv::Mat visualized_image = candidates.base_image.clone();
+    renderer.drawPath(visualized_image, best_path_info->path, candidates.fall_center_pixel, best_path_info->exit);
+
+    plan.visual_done = std::chrono::steady_clock::now();
 
-    std::string output_path = "./prev_cap_repo/" + fall_event_timestamp + "/path.jpg";
-    cv::imwrite(output_path, visualized_image);
+    // Encoded once: the same bytes are published and later archived by saveFallLog
+    TraceSpan encode_span(TraceStage::Encode);
+    if (!renderer.encode(visualized_image, plan.path_image))
+        std::cerr << "[VISUAL] Failed to encode path image" << std::endl;
+    encode_span.stop();
 
-    g_t_visual_done = std::chrono::steady_clock::now();
+    plan.encode_done = std::chrono::steady_clock::now();
 
-    std::cout << "[RENDER] Path image saved: " << output_path << std::endl;
+    plan.selected_gate_index = static_cast<int>(best_path_info->exit.index);
+    plan.score = best_path_info->score;
+    plan.ok = true;
 
-    int selected_gate_index = best_path_info.exit.index;
-    float final_score = best_path_info.score;
-    std::cout << "[PATH] Selected gate index: " << selected_gate_index + 1 << ", Score: " << final_score << std::endl;
+    return plan;
+}
+
+void controlGateLed(mqtt::async_client* _mqtt_client, Incident& _incident)
+{
+    const RoutePlan& plan = _incident.plan;
+    std::cout << "[PATH] Selected gate index: " << plan.selected_gate_index + 1 << ", Score: " << plan.score << std::endl;
 
     try
     {
-        std::string led_topic = "sub/led/on/" + std::to_string(selected_gate_index + 1);
+        std::string led_topic = "sub/led/on/" + std::to_string(plan.selected_gate_index + 1);
         auto led_msg = mqtt::make_message(led_topic, "");
         led_msg->set_qos(1);
         _mqtt_client->publish(led_msg);
 
         std::cout << "[MQTT] LED ON command published: " << led_topic << std::endl;
-
-        gate_led_turn_on_time = millis();
-        gate_led_is_on = true;
     }
     catch (const mqtt::exception& ex)
     {
         std::cerr << "[MQTT ERROR] Failed to publish LED command: " << ex.what() << std::endl;
     }
 
-    saveFallLog(_mqtt_client, fall_event_timestamp, fall_center_x, fall_center_y, selected_gate_index);
+    _incident.times.led_done = std::chrono::steady_clock::now();
 }
 
-void saveFallLog(mqtt::async_client* _mqtt_client,
-    const std::string& _event_timestamp,
-    int _fall_center_x,
-    int _fall_center_y,
-    int _selected_gate_index)
+void turnOffGateLed(mqtt::async_client* _mqtt_client, int _gate_index)
 {
-    float fall_to_gate_dist[3];
-    for (const auto& exit : dynamic_exit_points)
+    try
     {
-        int x = exit.location.x;
-        int y = exit.location.y;
-        int idx = exit.index;
-        fall_to_gate_dist[idx] = std::sqrt(
-            (fall_center_x - x) * (fall_center_x - x) +
-            (fall_center_y - y) * (fall_center_y - y)
-        );
-    }
+        std::string led_topic = "sub/led/off/" + std::to_string(_gate_index + 1);
+        auto led_msg = mqtt::make_message(led_topic, "");
+        led_msg->set_qos(1);
+        _mqtt_client->publish(led_msg);
 
-    json fall_log_json =
+        std::cout << "[MQTT] LED OFF command published: " << led_topic << std::endl;
+    }
+    catch (const mqtt::exception& ex)
     {
-                    { "event_time", _event_timestamp },
-                    { "fall_point_x", _fall_center_x },
-                    { "fall_point_y", _fall_center_y },
-                    { "min_gate_idx", _selected_gate_index + 1 },
-                    { "gate_1_people_count", sub_camera_crowd_counts.at(0)},
-                    { "gate_2_people_count", sub_camera_crowd_counts.at(1) },
-                    { "gate_3_people_count", sub_camera_crowd_counts.at(2) },
-                    { "indoor_people_count", detected_people_coordinates.size()},
-                    { "gate_1_dist", fall_to_gate_dist[0]},
-                    { "gate_2_dist", fall_to_gate_dist[1]},
-                    { "gate_3_dist", fall_to_gate_dist[2]},
-                    { "gate_1_score", paths_info.at(0).score},
-                    { "gate_2_score", paths_info.at(1).score},
-                    { "gate_3_score", paths_info.at(2).score}
-    };
+        std::cerr << "[MQTT ERROR] Failed to publish LED off command: " << ex.what() << std::endl;
+    }
+}
 
-    std::string log_directory = "./log";
-    if (!fs::exists(log_directory))
+void publishIncidentError(mqtt::async_client* _mqtt_client, const std::string& _event_timestamp, const std::string& _payload)
+{
+    try
+    {
+        std::string err_topic = "main/result/error/" + _event_timestamp;
+        auto err_msg = mqtt::make_message(err_topic, _payload);
+        err_msg->set_qos(1);
+        _mqtt_client->publish(err_msg);
+    }
+    catch (...)
     {
-        fs::create_directories(log_directory);
+        std::cerr << "[MQTT ERROR] Failed to publish error message: " << _payload << std::endl;
     }
+}
 
-    std::string log_file_path = log_directory + "/" + _event_timestamp + ".json";
+void publishTraceReport(mqtt::async_client* _mqtt_client)
+{
+    tracer().collect();
+    const std::string report = tracer().report(mqtt_client_id);
+
+    // The file goes through the archive writer, off the event loop
+    global_archive_writer.enqueueText(TRACE_DUMP_PATH, report, nullptr, ArchivePriority::Diagnostic);
 
     try
     {
-        std::ofstream output_file(log_file_path);
-        output_file << fall_log_json.dump(4);
-        output_file.close();
-        std::cout << "[LOG] JSON log saved: " << log_file_path << std::endl;
+        auto trace_msg = mqtt::make_message(mqtt_topic_trace_diag, report);
+        trace_msg->set_qos(0);
+        _mqtt_client->publish(trace_msg);
     }
-    catch (const std::exception& ex)
+    catch (const mqtt::exception& ex)
     {
-        std::cerr << "[LOG ERROR] Failed to write JSON file: " << ex.what() << std::endl;
+        std::cerr << "[MQTT ERROR] Failed to publish trace report: " << ex.what() << std::endl;
+    }
+}
 
-        try
-        {
-            std::string err_topic = "main/result/error/" + _event_timestamp;
-            std::string err_payload = "Failed to write JSON log: " + std::string(ex.what());
-            auto err_msg = mqtt::make_message(err_topic, err_payload);
-            err_msg->set_qos(1);
-            _mqtt_client->publish(err_msg);
-        }
-        catch (...)
-        {
-            std::cerr << "[MQTT ERROR] Failed to publish JSON log error message." << std::endl;
-        }
+void saveFallLog(mqtt::async_client* _mqtt_client, const Incident& _incident, bool _rerouted)
+{
+    const std::string& event_timestamp = _incident.timestamp;
+    const cv::Point& fall_center = _incident.analysis.fall_center;
+    const std::vector<uchar>& path_image = _incident.plan.path_image;
 
-        return;
+    std::array<float, SUB_CAMERA_COUNT> fall_to_gate_dist = {};
+    std::array<float, SUB_CAMERA_COUNT> gate_scores = {};
+    for (const auto& path_info : _incident.plan.paths)
+    {
+        const size_t idx = path_info.exit.index;
+        if (idx >= SUB_CAMERA_COUNT) continue;
+
+        const cv::Point delta = fall_center - path_info.exit.location;
+        fall_to_gate_dist[idx] = std::sqrt(static_cast<float>(delta.x * delta.x + delta.y * delta.y));
+        gate_scores[idx] = path_info.score;
     }
 
+    json fall_log_json =
+    {
+                    { "event_time", event_timestamp },
+                    { "fall_point_x", fall_center.x },
+                    { "fall_point_y", fall_center.y },
+                    { "min_gate_idx", _incident.plan.selected_gate_index + 1 },
+                    { "gate_1_people_count", _incident.plan.counts.at(0)},
+                    { "gate_2_people_count", _incident.plan.counts.at(1) },
+                    { "gate_3_people_count", _incident.plan.counts.at(2) },
+                    { "indoor_people_count", _incident.analysis.people.size()},
+                    { "gate_1_dist", fall_to_gate_dist[0]},
+                    { "gate_2_dist", fall_to_gate_dist[1]},
+                    { "gate_3_dist", fall_to_gate_dist[2]},
+                    { "gate_1_score", gate_scores[0]},
+                    { "gate_2_score", gate_scores[1]},
+                    { "gate_3_score", gate_scores[2]},
+                    { "rerouted", _rerouted }
+    };
+
+    // Gates whose count was estimated because the sub-camera missed the deadline
+    json estimated_gates = json::array();
+    for (size_t i = 0; i < _incident.plan.estimated.size(); ++i)
+    {
+        if (_incident.plan.estimated[i]) estimated_gates.push_back(i + 1);
+    }
+    fall_log_json["estimated_gates"] = estimated_gates;
+
     try
     {
         std::string log_topic = "main/result/log/";
@@ -950,16 +1249,12 @@ void saveFallLog(mqtt::async_client* _mqtt_client,
         std::cerr << "[MQTT ERROR] Failed to publish JSON log: " << ex.what() << std::endl;
     }
 
-    std::string image_path = "./prev_cap_repo/" + _event_timestamp + "/path.jpg";
-    if (fs::exists(image_path))
+    if (!path_image.empty())
     {
         try
         {
-            std::ifstream image_stream(image_path, std::ios::binary);
-            std::vector<char> image_buffer((std::istreambuf_iterator<char>(image_stream)), std::istreambuf_iterator<char>());
-
             std::string image_topic = "main/result/image/";
-            auto image_msg = mqtt::make_message(image_topic, image_buffer.data(), image_buffer.size());
+            auto image_msg = mqtt::make_message(image_topic, path_image.data(), path_image.size());
             image_msg->set_qos(1);
             _mqtt_client->publish(image_msg);
 
@@ -971,7 +1266,7 @@ void saveFallLog(mqtt::async_client* _mqtt_client,
 
             try
             {
-                std::string err_topic = "main/result/error/" + _event_timestamp;
+                std::string err_topic = "main/result/error/" + event_timestamp;
                 std::string err_payload = "Failed to publish image: " + std::string(ex.what());
                 auto err_msg = mqtt::make_message(err_topic, err_payload);
                 err_msg->set_qos(1);
@@ -985,12 +1280,12 @@ void saveFallLog(mqtt::async_client* _mqtt_client,
     }
     else
     {
-        std::cerr << "[ERROR] Image not found: " << image_path << std::endl;
+        std::cerr << "[ERROR] Path image not encoded for " << event_timestamp << std::endl;
 
         try
         {
-            std::string err_topic = "main/result/error/" + _event_timestamp;
-            std::string err_payload = "Path image not found: " + image_path;
+            std::string err_topic = "main/result/error/" + event_timestamp;
+            std::string err_payload = "Path image not encoded.";
             auto err_msg = mqtt::make_message(err_topic, err_payload);
             err_msg->set_qos(1);
             _mqtt_client->publish(err_msg);
@@ -1001,55 +1296,75 @@ void saveFallLog(mqtt::async_client* _mqtt_client,
         }
     }
 
-    g_t_publish_done = std::chrono::steady_clock::now();
-
-    std::cout << "\n======= [TIME LOG SUMMARY] =======" << std::endl;
-    std::cout << "[TIME] CH1 image detected ("
-        << std::chrono::duration_cast<std::chrono::milliseconds>(g_t_ch1_detected - g_t_mqtt_fall_triggered).count()
-        << " ms)" << std::endl;
+    const auto t_publish_done = std::chrono::steady_clock::now();
 
-    std::cout << "[TIME] Fall detection ("
-        << std::chrono::duration_cast<std::chrono::milliseconds>(g_t_fall_done - g_t_ch1_detected).count()
-        << " ms)" << std::endl;
+    // Archive after the response: path image, JSON log, then the summary once both are written.
+    // A re-route overwrites both with the final decision.
+    std::string output_path = "./prev_cap_repo/" + event_timestamp + "/path.jpg";
+    const ArchiveCallback record_timing = archiveTimingRecorder(event_timestamp);
+    global_archive_writer.enqueue(output_path, path_image, record_timing);
 
-    // std::cout << "[TIME] Crowd detection ("
-    //      << std::chrono::duration_cast<std::chrono::milliseconds>(g_t_crowd_done - g_t_fall_done).count()
-    //      << " ms)" << std::endl;
+    std::string log_file_path = "./log/" + event_timestamp + ".json";
+    global_archive_writer.enqueueText(log_file_path, fall_log_json.dump(4),
+        [_mqtt_client, event_timestamp, record_timing](const ArchiveTiming& timing) {
+            record_timing(timing);
+            if (timing.ok) return;
 
-    std::cout << "[TIME] All sub-camera counts received ("
-        << std::chrono::duration_cast<std::chrono::milliseconds>(g_t_subcrowd_done - g_t_ch1_detected).count()
-        << " ms)" << std::endl;
-
-    std::cout << "[TIME] Congestion analysis ("
-        << std::chrono::duration_cast<std::chrono::milliseconds>(g_t_congestion_done - g_t_subcrowd_done).count()
-        << " ms)" << std::endl;
-
-    std::cout << "[TIME] Pathfinding ("
-        << std::chrono::duration_cast<std::chrono::milliseconds>(g_t_path_done - g_t_congestion_done).count()
-        << " ms)" << std::endl;
-
-    std::cout << "[TIME] Visualization save ("
-        << std::chrono::duration_cast<std::chrono::milliseconds>(g_t_visual_done - g_t_path_done).count()
-        << " ms)" << std::endl;
-
-    std::cout << "[TIME] LED control + MQTT publish ("
-        << std::chrono::duration_cast<std::chrono::milliseconds>(g_t_publish_done - g_t_visual_done).count()
-        << " ms)" << std::endl;
+            try
+            {
+                std::string err_topic = "main/result/error/" + event_timestamp;
+                std::string err_payload = "Failed to write JSON log: " + timing.path;
+                auto err_msg = mqtt::make_message(err_topic, err_payload);
+                err_msg->set_qos(1);
+                _mqtt_client->publish(err_msg);
+            }
+            catch (...)
+            {
+                std::cerr << "[MQTT ERROR] Failed to publish JSON log error message." << std::endl;
+            }
+        });
 
-    std::cout << "[TIME] Total response time: "
-        << std::chrono::duration_cast<std::chrono::milliseconds>(g_t_publish_done - g_t_ch1_detected).count()
-        << " ms" << std::endl;
+    auto ms = [](std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(to - from).count();
+        };
+
+    const IncidentTimes& times = _incident.times;
+    const RoutePlan& plan = _incident.plan;
+
+    std::ostringstream summary;
+    summary << "\n======= [TIME LOG SUMMARY] =======" << std::endl;
+    summary << "[TIME] Incident #" << _incident.id << " (" << event_timestamp << ")" << (_rerouted ? " re-routed" : "") << std::endl;
+    summary << "[TIME] CH1 image detected (" << ms(times.triggered, times.captured) << " ms)" << std::endl;
+    const RouteCandidates& candidates = _incident.candidates;
+    summary << "[TIME] Fall detection (" << ms(times.captured, _incident.analysis.analyzed_at) << " ms)" << std::endl;
+    summary << "[TIME]   Speculative congestion analysis (" << ms(_incident.analysis.analyzed_at, candidates.congestion_done) << " ms)" << std::endl;
+    summary << "[TIME]   Speculative pathfinding (" << ms(candidates.congestion_done, candidates.path_done) << " ms)" << std::endl;
+    summary << "[TIME]   Speculative visualization (" << ms(candidates.path_done, candidates.visual_done) << " ms)" << std::endl;
+    summary << "[TIME] Sub-camera counts " << (_rerouted ? "re-routed on" : "ready") << " (" << ms(times.captured, times.counted) << " ms)" << std::endl;
+    summary << "[TIME] Rescoring (" << ms(times.counted, plan.rescore_done) << " ms)" << std::endl;
+    summary << "[TIME] Path drawing (" << ms(plan.rescore_done, plan.visual_done) << " ms)" << std::endl;
+    summary << "[TIME] Path image encoding (" << ms(plan.visual_done, plan.encode_done) << " ms)" << std::endl;
+    summary << "[TIME] LED control (" << ms(plan.encode_done, times.led_done) << " ms)" << std::endl;
+    summary << "[TIME] MQTT publish (" << ms(times.led_done, t_publish_done) << " ms)" << std::endl;
+    summary << "[TIME] Total response time: " << ms(times.captured, t_publish_done) << " ms" << std::endl;
+
+    const std::string response_summary = summary.str();
+    global_archive_writer.enqueueTask([response_summary, event_timestamp]() {
+        std::cout << response_summary;
+        for (const auto& timing : archive_timings[event_timestamp])
+        {
+            std::cout << "[TIME] Archive " << fs::path(timing.path).filename().string()
+                << (timing.ok ? "" : " FAILED") << " (queued " << static_cast<long>(timing.wait_ms)
+                << " ms, encode " << static_cast<long>(timing.encode_ms)
+                << " ms, write " << static_cast<long>(timing.write_ms) << " ms)" << std::endl;
+        }
+        std::cout << "===================================\n" << std::endl;
 
-    std::cout << "===================================\n" << std::endl;
+        archive_timings.erase(event_timestamp);
+        });
 
-    fall_center_x = -1;
-    fall_center_y = -1;
-    periodic_event_response_enabled = true;
-    fall_event_response_enabled = true;
-    fall_event_start_time = 0;
-    gate_led_is_on = false;
-    crowd_result_expected = false;
-    std::cout << "[STATE] Fall cycle complete. Detection re-enabled." << std::endl;
+    // The hold of the incident was released by its first publish
+    if (!_rerouted) global_archive_writer.release();
 }
 
 void clearCaptureRepoDirectory(const std::string& directory_path) {
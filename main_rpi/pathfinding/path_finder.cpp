@@ -4,36 +4,78 @@
 #include <cmath>
 #include <algorithm>
 #include <limits>
-#include <memory>
-#include <queue>
 
 // Project headers
 #include "path_finder.h"
 #include "config.h"
 
+namespace {
+	constexpr float k_diagonal = 1.41421356f;
+	constexpr int32_t k_no_parent = std::numeric_limits<int32_t>::min();
+	constexpr uint32_t k_padding_state = std::numeric_limits<uint32_t>::max();
+	constexpr uint32_t k_max_generation = (k_padding_state - 1) / 2;
+
+	// === Octile Distance: Exact Cost to the Goal on an Empty 8-connected Grid ===
+	inline float octileDistance(int x, int y, const cv::Point& goal) {
+		const int dx = std::abs(x - goal.x);
+		const int dy = std::abs(y - goal.y);
+		return static_cast<float>(std::max(dx, dy)) + (k_diagonal - 1.0f) * static_cast<float>(std::min(dx, dy));
+	}
+}
+
 // === Constructor ===
 Pathfinder::Pathfinder(int image_width, int image_height)
 	: image_size(image_width, image_height) {
 }
 
 // === Sets the Internal Congestion Map ===
-void Pathfinder::setCongestionMap(const std::vector<std::vector<float>>& congestion_grid_map) {
+void Pathfinder::setCongestionMap(GridView<const float> congestion_grid_map) {
 	this->congestion_grid_map = congestion_grid_map;
 }
 
 // === Generate Path Information ===
 PathInfo Pathfinder::generatePathInfo(const cv::Point& incident_location_pixel, const Exit& exit, CongestionAnalyzer& analyzer, const int& exit_outer_crowd_counts) {
+	PathInfo path_info = generatePathCandidate(incident_location_pixel, exit, analyzer);
+	scorePathInfo(path_info, exit_outer_crowd_counts);
+
+	return path_info;
+}
+
+// === Generate Count-independent Path Information ===
+PathInfo Pathfinder::generatePathCandidate(const cv::Point& incident_location_pixel, const Exit& exit, CongestionAnalyzer& analyzer) {
 	PathInfo path_info;
 	path_info.exit = exit;
 	path_info.exit_inner_congestion = calculateExitInnerCongestion(exit.location, analyzer);
-	path_info.exit_outer_congestion = calculateExitOuterCongestion(exit_outer_crowd_counts);
 	path_info.path = calculatePath(incident_location_pixel, exit.location);
 	path_info.path_cost = calculatePathCost(path_info.path);
-	path_info.score = calculateScore(path_info.path_cost, path_info.exit_inner_congestion, path_info.exit_outer_congestion);
 
 	return path_info;
 }
 
+// === Generate Count-independent Path Information for Every Exit in One Search ===
+std::vector<PathInfo> Pathfinder::generatePathCandidates(const cv::Point& incident_location_pixel, const std::vector<Exit>& exits, CongestionAnalyzer& analyzer) {
+	std::vector<cv::Point> exit_locations;
+	for (const auto& exit : exits) exit_locations.push_back(exit.location);
+
+	std::vector<std::vector<cv::Point>> paths = calculatePaths(incident_location_pixel, exit_locations);
+
+	std::vector<PathInfo> path_infos(exits.size());
+	for (size_t i = 0; i < exits.size(); ++i) {
+		path_infos[i].exit = exits[i];
+		path_infos[i].exit_inner_congestion = calculateExitInnerCongestion(exits[i].location, analyzer);
+		path_infos[i].path = std::move(paths[i]);
+		path_infos[i].path_cost = calculatePathCost(path_infos[i].path);
+	}
+
+	return path_infos;
+}
+
+// === Score with Outer Crowd Counts ===
+void Pathfinder::scorePathInfo(PathInfo& path_info, const int& exit_outer_crowd_counts) {
+	path_info.exit_outer_congestion = calculateExitOuterCongestion(exit_outer_crowd_counts);
+	path_info.score = calculateScore(path_info.path_cost, path_info.exit_inner_congestion, path_info.exit_outer_congestion);
+}
+
 // === Calculate Inner Congestion around Exit ===
 float Pathfinder::calculateExitInnerCongestion(const cv::Point& exit_location_pixel, CongestionAnalyzer& analyzer) {
 	float max_inner_congestion = 1e-6f;
@@ -59,70 +101,190 @@ std::vector<cv::Point> Pathfinder::calculatePath(const cv::Point& start_pixel, c
 	std::vector<cv::Point> empty;
 
 	try {
-		if (congestion_grid_map.empty() || congestion_grid_map[0].empty()) throw std::runtime_error("Congestion map is empty.");
+		if (congestion_grid_map.empty()) throw std::runtime_error("Congestion map is empty.");
 
-		int rows = static_cast<int>(congestion_grid_map.size());
-		int cols = static_cast<int>(congestion_grid_map[0].size());
+		const cv::Point grid_start = toGrid(start_pixel);
+		const cv::Point grid_goal = toGrid(goal_pixel);
+		if (!congestion_grid_map.contains(grid_start) || !congestion_grid_map.contains(grid_goal)) return empty;
 
-		struct Node {
-			int x, y;
-			float g, h;
-			std::shared_ptr<Node> parent;
-			float f() const { return g + h; }
-		};
+		prepareSearch();
 
-		auto cmp = [](const std::shared_ptr<Node>& a, const std::shared_ptr<Node>& b) { return a->f() > b->f(); };
-		std::priority_queue<std::shared_ptr<Node>, std::vector<std::shared_ptr<Node>>, decltype(cmp)> open(cmp);
-		std::vector<std::vector<bool>> visited(rows, std::vector<bool>(cols, false));
+		if (searchFrom(grid_start, { grid_goal }) > 0) return empty;
 
-		cv::Point grid_start = toGrid(start_pixel);
-		cv::Point grid_goal = toGrid(goal_pixel);
+		return tracePath(cellId(grid_goal));
+	}
+	catch (const std::exception& e) {
+		std::cerr << "[Pathfinder::findPath] Error: " << e.what() << std::endl;
+	}
 
-		float initial_h = static_cast<float>(cv::norm(grid_start - grid_goal));
-		open.push(std::make_shared<Node>(Node{ grid_start.x, grid_start.y, 0.0f, initial_h, nullptr }));
+	return empty;
+}
 
-		const std::vector<cv::Point> directions = { {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {-1, 1}, {-1, -1}, {1, -1} };
+// === Paths from a Start to Several Goals: A* per Goal, or One Sweep for Many Goals ===
+std::vector<std::vector<cv::Point>> Pathfinder::calculatePaths(const cv::Point& start_pixel, const std::vector<cv::Point>& goal_pixels) {
+	if (goal_pixels.size() >= static_cast<size_t>(PATH_SWEEP_MIN_GOALS)) return calculatePathsBySweep(start_pixel, goal_pixels);
 
-		while (!open.empty()) {
-			auto current = open.top();
-			open.pop();
+	std::vector<std::vector<cv::Point>> paths;
+	for (const auto& goal_pixel : goal_pixels) paths.push_back(calculatePath(start_pixel, goal_pixel));
 
-			if (current->x == grid_goal.x && current->y == grid_goal.y) {
-				std::vector<cv::Point> path;
-				for (auto n = current; n; n = n->parent) {
-					path.push_back(toPixelCenter(cv::Point(n->x, n->y)));
-				}
-				std::reverse(path.begin(), path.end());
-				return path;
-			}
+	return paths;
+}
 
-			if (current->x < 0 || current->y < 0 || current->x >= cols || current->y >= rows) continue;
-			if (visited[current->y][current->x]) continue;
-			visited[current->y][current->x] = true;
+// === One Dijkstra Sweep from a Start to Several Goals ===
+std::vector<std::vector<cv::Point>> Pathfinder::calculatePathsBySweep(const cv::Point& start_pixel, const std::vector<cv::Point>& goal_pixels) {
+	std::vector<std::vector<cv::Point>> paths(goal_pixels.size());
 
-			for (const auto& d : directions) {
-				int nx = current->x + d.x;
-				int ny = current->y + d.y;
+	try {
+		if (congestion_grid_map.empty()) throw std::runtime_error("Congestion map is empty.");
 
-				if (nx < 0 || ny < 0 || nx >= cols || ny >= rows) continue;
-				if (visited[ny][nx]) continue;
+		const cv::Point grid_start = toGrid(start_pixel);
+		if (!congestion_grid_map.contains(grid_start)) return paths;
 
-				float congestion = congestion_grid_map[ny][nx];
-				float dist = std::hypot(static_cast<float>(d.x), static_cast<float>(d.y));
-				float cost = dist * (1.0f + congestion);
+		prepareSearch();
 
-				float g = current->g + cost;
-				float h = static_cast<float>(cv::norm(cv::Point(nx, ny) - grid_goal));
+		// Goals outside the map keep an empty path; the others share one search tree
+		std::vector<int32_t> goal_ids(goal_pixels.size(), k_no_parent);
+		std::vector<cv::Point> grid_goals;
+		for (size_t i = 0; i < goal_pixels.size(); ++i) {
+			const cv::Point grid_goal = toGrid(goal_pixels[i]);
+			if (!congestion_grid_map.contains(grid_goal)) continue;
 
-				open.push(std::make_shared<Node>(Node{ nx, ny, g, h, current }));
-			}
+			goal_ids[i] = cellId(grid_goal);
+			grid_goals.push_back(grid_goal);
+		}
+		if (grid_goals.empty()) return paths;
+
+		searchFrom(grid_start, grid_goals);
+
+		const uint32_t closed_mark = 2 * generation + 1;
+		for (size_t i = 0; i < goal_ids.size(); ++i) {
+			if (goal_ids[i] != k_no_parent && cell_state.row(0)[goal_ids[i]] == closed_mark) paths[i] = tracePath(goal_ids[i]);
 		}
 	}
 	catch (const std::exception& e) {
-		std::cerr << "[Pathfinder::findPath] Error: " << e.what() << std::endl;
+		std::cerr << "[Pathfinder::calculatePathsBySweep] Error: " << e.what() << std::endl;
 	}
 
-	return empty;
+	return paths;
+}
+
+// === Expand from the Start until Every Goal Is Settled ===
+size_t Pathfinder::searchFrom(const cv::Point& grid_start, const std::vector<cv::Point>& grid_goals) {
+	const int32_t stride = static_cast<int32_t>(cell_state.stride());
+	const uint32_t open_mark = 2 * generation;
+	const uint32_t closed_mark = 2 * generation + 1;
+
+	// Cell ids are offsets from cell (0, 0); the padding ring is always closed, so neighbors need no bounds check
+	uint32_t* state = cell_state.row(0);
+	float* g = g_score.row(0);
+	int32_t* came_from = parent.row(0);
+
+	const int dx[8] = { 1, -1, 0, 0, 1, -1, -1, 1 };
+	const int dy[8] = { 0, 0, 1, -1, 1, 1, -1, -1 };
+	const float step[8] = { 1.0f, 1.0f, 1.0f, 1.0f, k_diagonal, k_diagonal, k_diagonal, k_diagonal };
+	int32_t offset[8];
+	for (int d = 0; d < 8; ++d) offset[d] = dy[d] * stride + dx[d];
+
+	// Distinct goal cells, sorted for the membership test on each closed cell
+	std::vector<int32_t> goal_ids;
+	for (const auto& goal : grid_goals) goal_ids.push_back(cellId(goal));
+	std::sort(goal_ids.begin(), goal_ids.end());
+	goal_ids.erase(std::unique(goal_ids.begin(), goal_ids.end()), goal_ids.end());
+	size_t goals_left = goal_ids.size();
+
+	// A* toward a single goal; with several, no heuristic: each closes at its exact cost and no key goes stale
+	const bool single_goal = goals_left == 1;
+	const cv::Point target = grid_goals.front();
+	auto heuristic = [single_goal, &target](int x, int y) {
+		return single_goal ? octileDistance(x, y, target) : 0.0f;
+	};
+
+	const int32_t start_id = cellId(grid_start);
+	const float start_h = heuristic(grid_start.x, grid_start.y);
+
+	open_heap.reset(heap_position.row(0));
+	state[start_id] = open_mark;
+	g[start_id] = 0.0f;
+	came_from[start_id] = k_no_parent;
+	open_heap.push(start_id, start_h, start_h);
+
+	while (!open_heap.empty()) {
+		const int32_t current = open_heap.pop().id;
+		state[current] = closed_mark;
+
+		// A closed cell's g is final; each cell closes once, so each goal is counted once
+		if (std::binary_search(goal_ids.begin(), goal_ids.end(), current) && --goals_left == 0) break;
+
+		const int x = current % stride;
+		const int y = current / stride;
+		const float current_g = g[current];
+
+		for (int d = 0; d < 8; ++d) {
+			const int32_t next = current + offset[d];
+			const uint32_t next_state = state[next];
+			if (next_state >= closed_mark) continue;  // Closed in this search, or padding
+
+			const int nx = x + dx[d];
+			const int ny = y + dy[d];
+			const float next_g = current_g + step[d] * (1.0f + congestion_grid_map.row(ny)[nx]);
+
+			if (next_state == open_mark) {
+				if (next_g >= g[next]) continue;
+
+				g[next] = next_g;
+				came_from[next] = current;
+				const float h = heuristic(nx, ny);
+				open_heap.decrease(next, next_g + h, h);
+			}
+			else {
+				state[next] = open_mark;
+				g[next] = next_g;
+				came_from[next] = current;
+				const float h = heuristic(nx, ny);
+				open_heap.push(next, next_g + h, h);
+			}
+		}
+	}
+
+	return goals_left;
+}
+
+// === Follow the Parents from a Settled Cell back to the Start ===
+std::vector<cv::Point> Pathfinder::tracePath(int32_t goal_id) const {
+	const int32_t stride = static_cast<int32_t>(cell_state.stride());
+	const int32_t* came_from = parent.row(0);
+
+	std::vector<cv::Point> path;
+	for (int32_t id = goal_id; id != k_no_parent; id = came_from[id]) {
+		path.push_back(toPixelCenter(cv::Point(id % stride, id / stride)));
+	}
+	std::reverse(path.begin(), path.end());
+
+	return path;
+}
+
+// === Cell Id in the Search Arrays ===
+int32_t Pathfinder::cellId(const cv::Point& grid_cell) const {
+	return grid_cell.y * static_cast<int32_t>(cell_state.stride()) + grid_cell.x;
+}
+
+// === Size the Search Arrays and Start a New Generation ===
+void Pathfinder::prepareSearch() {
+	const int rows = congestion_grid_map.rows();
+	const int cols = congestion_grid_map.cols();
+
+	if (cell_state.rows() != rows || cell_state.cols() != cols || generation >= k_max_generation) {
+		cell_state = Grid<uint32_t>(rows, cols, 1, k_padding_state);
+		for (int y = 0; y < rows; ++y) std::fill(cell_state.row(y), cell_state.row(y) + cols, 0u);
+
+		g_score = Grid<float>(rows, cols, 1, 0.0f);
+		parent = Grid<int32_t>(rows, cols, 1, k_no_parent);
+		heap_position = Grid<int32_t>(rows, cols, 1, 0);
+		open_heap.reserve(static_cast<size_t>(rows) * cols / 4);
+		generation = 0;
+	}
+
+	++generation;
 }
 
 // === Calculates Cost of a Path based on Congestion and Distance ===
@@ -133,11 +295,7 @@ float Pathfinder::calculatePathCost(const std::vector<cv::Point>& path) {
 	for (size_t i = 1; i < path.size(); ++i) {
 		float dist = cv::norm(path[i] - path[i - 1]);
 
-		cv::Point grid_pt = toGrid(path[i]);
-		int gx = grid_pt.x;
-		int gy = grid_pt.y;
-
-		float congestion = (gy >= 0 && gy < static_cast<int>(congestion_grid_map.size()) && gx >= 0 && gx < static_cast<int>(congestion_grid_map[0].size())) ? congestion_grid_map[gy][gx] : 0.0f;
+		float congestion = congestion_grid_map.valueOr(toGrid(path[i]), 0.0f);
 		path_cost += dist * (1.0f + congestion);
 	}
 
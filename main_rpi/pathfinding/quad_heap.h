@@ -0,0 +1,113 @@
+#ifndef QUAD_HEAP_H
+#define QUAD_HEAP_H
+
+// Standard Library
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief 4-ary min-heap of cell ids with decrease-key.
+ *
+ * Keys are (f, h): ties on f go to the entry closer to the goal, which keeps
+ * A* from widening over equal-cost fronts. The heap writes each cell's
+ * position into a caller-owned array indexed by cell id, so decrease() finds
+ * an entry in O(1). Four children per node halve the depth of a binary heap;
+ * sift-down compares the children in one cache line.
+ */
+class QuadHeap {
+public:
+    struct Entry {
+        float f;
+        float h;
+        int32_t id;
+    };
+
+    /**
+     * @brief Empties the heap and sets the position array (indexed by id; may be offset for negative ids).
+     */
+    void reset(int32_t* position_by_id) {
+        entries.clear();
+        position = position_by_id;
+    }
+
+    bool empty() const { return entries.empty(); }
+    size_t size() const { return entries.size(); }
+    void reserve(size_t count) { entries.reserve(count); }
+
+    /**
+     * @brief Inserts a cell that is not in the heap.
+     */
+    void push(int32_t id, float f, float h) {
+        entries.push_back({ f, h, id });
+        siftUp(entries.size() - 1);
+    }
+
+    /**
+     * @brief Lowers the key of a cell in the heap.
+     */
+    void decrease(int32_t id, float f, float h) {
+        const size_t index = static_cast<size_t>(position[id]);
+        entries[index].f = f;
+        entries[index].h = h;
+        siftUp(index);
+    }
+
+    /**
+     * @brief Removes and returns the entry with the smallest key.
+     */
+    Entry pop() {
+        const Entry top = entries.front();
+        const Entry last = entries.back();
+        entries.pop_back();
+        if (!entries.empty()) {
+            entries.front() = last;
+            siftDown(0);
+        }
+        return top;
+    }
+
+private:
+    static bool less(const Entry& a, const Entry& b) {
+        return a.f < b.f || (a.f == b.f && a.h < b.h);
+    }
+
+    void siftUp(size_t index) {
+        const Entry moving = entries[index];
+        while (index > 0) {
+            const size_t parent = (index - 1) / 4;
+            if (!less(moving, entries[parent])) break;
+            entries[index] = entries[parent];
+            position[entries[index].id] = static_cast<int32_t>(index);
+            index = parent;
+        }
+        entries[index] = moving;
+        position[moving.id] = static_cast<int32_t>(index);
+    }
+
+    void siftDown(size_t index) {
+        const Entry moving = entries[index];
+        const size_t count = entries.size();
+        for (;;) {
+            const size_t first = index * 4 + 1;
+            if (first >= count) break;
+
+            size_t best = first;
+            const size_t end = first + 4 < count ? first + 4 : count;
+            for (size_t child = first + 1; child < end; ++child) {
+                if (less(entries[child], entries[best])) best = child;
+            }
+
+            if (!less(entries[best], moving)) break;
+            entries[index] = entries[best];
+            position[entries[index].id] = static_cast<int32_t>(index);
+            index = best;
+        }
+        entries[index] = moving;
+        position[moving.id] = static_cast<int32_t>(index);
+    }
+
+    std::vector<Entry> entries;
+    int32_t* position = nullptr;
+};
+
+#endif  // QUAD_HEAP_H
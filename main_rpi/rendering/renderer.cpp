@@ -85,30 +85,21 @@ void Renderer::drawCrowd(cv::Mat& image, const std::vector<cv::Point>& people, i
 }
 
 // === Draw Congestion Heatmap ===
-void Renderer::drawCongestionHeatmap(cv::Mat& image, const std::vector<std::vector<float>>& congestion_grid_map) {
+void Renderer::drawCongestionHeatmap(cv::Mat& image, GridView<const float> congestion_grid_map) {
     try {
-        if (congestion_grid_map.empty() || congestion_grid_map[0].empty()) throw std::runtime_error("Congestion map is empty.");
+        if (congestion_grid_map.empty()) throw std::runtime_error("Congestion map is empty.");
 
-        const int rows = static_cast<int>(congestion_grid_map.size());
-        const int cols = static_cast<int>(congestion_grid_map[0].size());
-
-        cv::Mat float_map(rows, cols, CV_32FC1);
-        float max_val = 0.0f;
-
-        for (int y = 0; y < rows; ++y) {
-            for (int x = 0; x < cols; ++x) {
-                float val = congestion_grid_map[y][x];
-                float_map.at<float>(y, x) = val;
-                max_val = std::max(max_val, val);
-            }
-        }
+        // Read in place; the grid is not copied
+        const cv::Mat float_map = congestion_grid_map.asMat();
+        double max_val = 0.0;
+        cv::minMaxLoc(float_map, nullptr, &max_val);
 
         // Upscale to match original image resolution
         cv::Mat upscaled;
         cv::resize(float_map, upscaled, image.size(), 0, 0, cv::INTER_CUBIC);
 
         // Normalize to [0,1]
-        if (max_val > 1e-6f) {
+        if (max_val > 1e-6) {
             upscaled /= max_val;
         }
         else {
@@ -223,4 +214,9 @@ void Renderer::drawPath(cv::Mat& image, const std::vector<cv::Point>& path, cons
 
     // Draw text
     cv::putText(image, start_label, start_text_pos, cv::FONT_HERSHEY_SIMPLEX, font_scale, start_text_color, thickness, cv::LINE_AA);
-}
\ No newline at end of file
+}
+
+// === Encode Rendered Frame ===
+bool Renderer::encode(const cv::Mat& image, std::vector<unsigned char>& out, const JpegEncodeOptions& options) const {
+    return jpegCodec().encode(image, out, options);
+}
@@ -0,0 +1,239 @@
+// Standard Library
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <algorithm>
+#include <iterator>
+
+// Project headers
+#include "replay_driver.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+    const std::string k_timeline_file = "timeline.txt";
+    const std::string k_replay_client_uri = "tcp://localhost:1883";
+    const std::string k_replay_client_id = "main_pi_replay";
+    constexpr std::chrono::milliseconds k_claim_poll_interval(5);
+}
+
+// === Constructor ===
+ReplayMqttClient::ReplayMqttClient()
+    : mqtt::async_client(k_replay_client_uri, k_replay_client_id)
+{
+}
+
+// === Records a message instead of sending it ===
+mqtt::delivery_token_ptr ReplayMqttClient::publish(mqtt::const_message_ptr message)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++published[message->get_topic()];
+    }
+
+    return mqtt::delivery_token::create(*this, message);
+}
+
+// === Messages published per topic ===
+std::map<std::string, size_t> ReplayMqttClient::publishedTopics() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return published;
+}
+
+// === Prints the messages published per topic ===
+void ReplayMqttClient::printSummary() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::cout << "[REPLAY] Published messages:" << std::endl;
+    for (const auto& [topic, count] : published)
+    {
+        std::cout << "  " << topic << ": " << count << std::endl;
+    }
+}
+
+// === Constructor ===
+ReplayDriver::ReplayDriver(const std::string& replay_directory, CaptureWatcher& capture_watcher,
+    mqtt::callback& callback, double speed)
+    : replay_directory(replay_directory),
+    capture_watcher(capture_watcher),
+    callback(callback),
+    speed(speed),
+    stop_requested(false),
+    done(false),
+    delivered_count(0),
+    unclaimed_count(0)
+{
+}
+
+// === Destructor ===
+ReplayDriver::~ReplayDriver()
+{
+    stop();
+}
+
+// === Reads the timeline ===
+bool ReplayDriver::load()
+{
+    const fs::path timeline_path = fs::path(replay_directory) / k_timeline_file;
+    std::ifstream input(timeline_path);
+    if (!input)
+    {
+        std::cerr << "[REPLAY] Cannot open " << timeline_path << std::endl;
+        return false;
+    }
+
+    events.clear();
+
+    std::string line;
+    size_t line_number = 0;
+    while (std::getline(input, line))
+    {
+        ++line_number;
+
+        std::istringstream fields(line);
+        long long at_ms = 0;
+        std::string kind;
+        if (line.empty() || line[0] == '#' || !(fields >> at_ms)) continue;
+
+        ReplayEvent event;
+        event.at = std::chrono::milliseconds(at_ms);
+
+        fields >> kind;
+        if (kind == "mqtt" && (fields >> event.topic))
+        {
+            event.kind = ReplayEvent::Kind::Message;
+            std::getline(fields >> std::ws, event.payload);
+        }
+        else if (kind == "image" && (fields >> event.file))
+        {
+            event.kind = ReplayEvent::Kind::Image;
+        }
+        else
+        {
+            std::cerr << "[REPLAY] " << timeline_path << ":" << line_number << ": cannot parse \"" << line << "\"" << std::endl;
+            return false;
+        }
+
+        events.push_back(std::move(event));
+    }
+
+    // Recorded logs may interleave sources; play them in time order
+    std::stable_sort(events.begin(), events.end(), [](const ReplayEvent& a, const ReplayEvent& b) {
+        return a.at < b.at;
+        });
+
+    std::cout << "[REPLAY] Loaded " << events.size() << " events over " << duration().count() << " ms" << std::endl;
+
+    return true;
+}
+
+// === Starts the replay thread ===
+void ReplayDriver::start()
+{
+    if (worker.joinable()) return;
+
+    stop_requested = false;
+    done = false;
+    worker = std::thread(&ReplayDriver::playLoop, this);
+}
+
+// === Stops playback ===
+void ReplayDriver::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop_requested = true;
+    }
+    stop_cv.notify_all();
+
+    if (worker.joinable()) worker.join();
+}
+
+// === Timeline length ===
+std::chrono::milliseconds ReplayDriver::duration() const
+{
+    return events.empty() ? std::chrono::milliseconds(0) : events.back().at;
+}
+
+// === Plays the timeline ===
+void ReplayDriver::playLoop()
+{
+    const auto started = std::chrono::steady_clock::now();
+
+    for (const auto& event : events)
+    {
+        if (speed > 0.0)
+        {
+            const auto offset = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double, std::milli>(event.at.count() / speed));
+
+            std::unique_lock<std::mutex> lock(mutex);
+            if (stop_cv.wait_until(lock, started + offset, [this]() { return stop_requested; })) return;
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stop_requested) return;
+        }
+
+        deliver(event);
+        ++delivered_count;
+    }
+
+    done = true;
+}
+
+// === Delivers one event ===
+void ReplayDriver::deliver(const ReplayEvent& event)
+{
+    if (event.kind == ReplayEvent::Kind::Image)
+    {
+        deliverImage(event.file);
+        return;
+    }
+
+    try
+    {
+        callback.message_arrived(mqtt::make_message(event.topic, event.payload));
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "[REPLAY] Callback failed on " << event.topic << ": " << ex.what() << std::endl;
+    }
+}
+
+// === Hands an image to the capture watcher ===
+bool ReplayDriver::deliverImage(const std::string& file)
+{
+    const fs::path source = fs::path(replay_directory) / file;
+    std::ifstream input(source, std::ios::binary);
+    if (!input)
+    {
+        std::cerr << "[REPLAY] Cannot read " << source << std::endl;
+        ++unclaimed_count;
+        return false;
+    }
+
+    CaptureFrame frame;
+    frame.name = source.filename().string();
+    frame.data.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+
+    // The rule is armed by the controller thread once it has applied the trigger; deliver() leaves the frame intact until a rule takes it
+    const auto give_up = std::chrono::steady_clock::now() + std::chrono::milliseconds(REPLAY_CLAIM_TIMEOUT_MS);
+    while (!capture_watcher.deliver(std::move(frame)))
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (stop_requested || std::chrono::steady_clock::now() >= give_up)
+        {
+            std::cerr << "[REPLAY] No armed rule took " << frame.name << std::endl;
+            ++unclaimed_count;
+            return false;
+        }
+        stop_cv.wait_for(lock, k_claim_poll_interval);
+    }
+
+    return true;
+}
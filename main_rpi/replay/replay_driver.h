@@ -0,0 +1,181 @@
+#ifndef REPLAY_DRIVER_H
+#define REPLAY_DRIVER_H
+
+// Standard Library
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+
+// MQTT
+#include <mqtt/async_client.h>
+
+// Project headers
+#include "capture_watcher.h"
+#include "config.h"
+
+/**
+ * @brief In-process stand-in for the broker connection of the main server.
+ *
+ * Never connects: publish() records the message and returns at once, so the
+ * pipeline code that takes an mqtt::async_client runs unchanged against it.
+ */
+class ReplayMqttClient : public mqtt::async_client
+{
+public:
+    ReplayMqttClient();
+
+    using mqtt::async_client::publish;
+
+    /**
+     * @brief Records a message instead of sending it.
+     */
+    mqtt::delivery_token_ptr publish(mqtt::const_message_ptr message) override;
+
+    /**
+     * @brief Returns the number of messages published per topic.
+     */
+    std::map<std::string, size_t> publishedTopics() const;
+
+    /**
+     * @brief Prints the number of messages published per topic.
+     */
+    void printSummary() const;
+
+private:
+    mutable std::mutex mutex;
+    std::map<std::string, size_t> published;
+};
+
+/**
+ * @brief One entry of a replay timeline.
+ */
+struct ReplayEvent
+{
+    enum class Kind
+    {
+        Message,    ///< MQTT message delivered to the callback
+        Image       ///< Capture handed to the CaptureWatcher
+    };
+
+    std::chrono::milliseconds at{ 0 };  ///< Offset from the start of the replay
+    Kind kind = Kind::Message;
+    std::string topic;                  ///< Message
+    std::string payload;                ///< Message
+    std::string file;                   ///< Image, relative to the replay directory
+};
+
+/**
+ * @brief Plays a recorded timeline of MQTT messages and captures into the main server.
+ *
+ * The replay directory holds the recorded CH1 images and a timeline.txt with
+ * one event per line, in milliseconds from the start:
+ *
+ *     <ms> mqtt <topic> [payload]
+ *     <ms> image <file>
+ *
+ * Messages go to the server's MQTT callback on the replay thread, as the
+ * broker would deliver them. Images go to the CaptureWatcher in memory, like
+ * a file received by the FTP receiver; an image no rule is armed for yet
+ * is retried for up to REPLAY_CLAIM_TIMEOUT_MS, since a camera upload never
+ * overtakes the trigger it answers. Lines starting with '#' are ignored.
+ */
+class ReplayDriver
+{
+public:
+    /**
+     * @brief Constructs the driver (nothing is loaded yet).
+     * @param Replay directory
+     * @param Watcher the images are delivered to
+     * @param Callback the messages are delivered to
+     * @param Playback speed (1 real time, 2 twice as fast, 0 as fast as possible)
+     */
+    ReplayDriver(const std::string& replay_directory, CaptureWatcher& capture_watcher,
+        mqtt::callback& callback, double speed);
+
+    /**
+     * @brief Stops the replay thread.
+     */
+    ~ReplayDriver();
+
+    ReplayDriver(const ReplayDriver&) = delete;
+    ReplayDriver& operator=(const ReplayDriver&) = delete;
+
+    /**
+     * @brief Reads timeline.txt from the replay directory.
+     * @return false if it is missing or a line cannot be parsed
+     */
+    bool load();
+
+    /**
+     * @brief Starts playing the timeline on a separate thread.
+     */
+    void start();
+
+    /**
+     * @brief Stops playback and waits for the thread.
+     */
+    void stop();
+
+    /**
+     * @brief Returns true once every event has been delivered.
+     */
+    bool finished() const { return done.load(); }
+
+    /**
+     * @brief Returns the number of events delivered so far.
+     */
+    size_t delivered() const { return delivered_count.load(); }
+
+    /**
+     * @brief Returns the number of images no capture rule took.
+     */
+    size_t unclaimed() const { return unclaimed_count.load(); }
+
+    /**
+     * @brief Returns the number of events in the timeline.
+     */
+    size_t size() const { return events.size(); }
+
+    /**
+     * @brief Returns the timeline length (offset of the last event).
+     */
+    std::chrono::milliseconds duration() const;
+
+private:
+    /**
+     * @brief Plays the timeline; executed in a separate thread.
+     */
+    void playLoop();
+
+    /**
+     * @brief Delivers one event.
+     */
+    void deliver(const ReplayEvent& event);
+
+    /**
+     * @brief Reads an image and hands it to the watcher once a rule takes it.
+     * @return false if it could not be read or no rule took it in time
+     */
+    bool deliverImage(const std::string& file);
+
+    // === Members ===
+    std::string replay_directory;
+    CaptureWatcher& capture_watcher;
+    mqtt::callback& callback;
+    double speed;
+    std::vector<ReplayEvent> events;
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable stop_cv;
+    bool stop_requested;
+    std::atomic<bool> done;
+    std::atomic<size_t> delivered_count;
+    std::atomic<size_t> unclaimed_count;
+};
+
+#endif // REPLAY_DRIVER_H
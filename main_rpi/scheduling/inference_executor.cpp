@@ -0,0 +1,210 @@
+// Standard Library
+#include <iostream>
+#include <utility>
+#include <algorithm>
+
+// Project headers
+#include "inference_executor.h"
+
+namespace {
+    size_t classIndex(JobClass job_class)
+    {
+        return static_cast<size_t>(job_class);
+    }
+
+    float elapsedMs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+    {
+        return std::chrono::duration<float, std::milli>(to - from).count();
+    }
+}
+
+// === Constructor ===
+InferenceExecutor::InferenceExecutor(size_t worker_count, size_t queue_capacity)
+    : capacity(std::max<size_t>(queue_capacity, 1)),
+    running(true)
+{
+    const size_t count = std::max<size_t>(worker_count, 1);
+
+    workers.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        workers.emplace_back(&InferenceExecutor::workerLoop, this);
+    }
+}
+
+// === Destructor ===
+InferenceExecutor::~InferenceExecutor()
+{
+    stop();
+}
+
+// === Queues a job ===
+bool InferenceExecutor::submit(JobClass job_class, std::function<void()> job)
+{
+    const size_t index = classIndex(job_class);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running) return false;
+
+        JobClassStats& stats = counters[index];
+        std::deque<Job>& queue = queues[index];
+        Job entry{ std::move(job), std::chrono::steady_clock::now() };
+
+        // All workers are busy: a newer periodic frame supersedes the waiting one
+        if (job_class == JobClass::Periodic && !queue.empty())
+        {
+            queue.back() = std::move(entry);
+            ++stats.coalesced;
+            ++stats.submitted;
+
+            return true;
+        }
+
+        if (queuedCount() >= capacity)
+        {
+            // Make room by dropping the oldest job of the lowest class below this one
+            bool evicted = false;
+            for (size_t lower = JOB_CLASS_COUNT; lower-- > index + 1;)
+            {
+                if (queues[lower].empty()) continue;
+
+                queues[lower].pop_front();
+                counters[lower].depth = queues[lower].size();
+                ++counters[lower].evicted;
+                evicted = true;
+                break;
+            }
+
+            if (!evicted)
+            {
+                ++stats.rejected;
+                std::cerr << "[EXECUTOR] Queue full, rejected " << jobClassName(job_class) << " job" << std::endl;
+
+                return false;
+            }
+        }
+
+        queue.push_back(std::move(entry));
+        ++stats.submitted;
+        stats.depth = queue.size();
+        stats.peak_depth = std::max(stats.peak_depth, stats.depth);
+    }
+
+    cv.notify_one();
+
+    return true;
+}
+
+// === Discards queued jobs and waits for running ones ===
+void InferenceExecutor::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running) return;
+
+        running = false;
+        for (size_t i = 0; i < JOB_CLASS_COUNT; ++i)
+        {
+            queues[i].clear();
+            counters[i].depth = 0;
+        }
+    }
+
+    cv.notify_all();
+
+    for (auto& worker : workers)
+    {
+        if (worker.joinable()) worker.join();
+    }
+    workers.clear();
+}
+
+// === Counter Snapshot ===
+JobClassStats InferenceExecutor::stats(JobClass job_class) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return counters[classIndex(job_class)];
+}
+
+// === Prints the counters of every job class ===
+void InferenceExecutor::printStats() const
+{
+    for (size_t i = 0; i < JOB_CLASS_COUNT; ++i)
+    {
+        const JobClass job_class = static_cast<JobClass>(i);
+        const JobClassStats s = stats(job_class);
+
+        std::cout << "[EXECUTOR] " << jobClassName(job_class)
+            << ": depth " << s.depth << " (peak " << s.peak_depth << ")"
+            << ", done " << s.completed << "/" << s.submitted
+            << ", coalesced " << s.coalesced << ", evicted " << s.evicted << ", rejected " << s.rejected
+            << ", wait avg " << s.averageWaitMs() << " / max " << s.max_wait_ms << " ms"
+            << ", run avg " << s.averageRunMs() << " / max " << s.max_run_ms << " ms" << std::endl;
+    }
+}
+
+// === Worker loop ===
+void InferenceExecutor::workerLoop()
+{
+    while (true)
+    {
+        Job job;
+        size_t index = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this] {
+                return !running || queuedCount() > 0;
+                });
+
+            if (!running) break;
+
+            // Highest class first; FIFO within a class
+            while (queues[index].empty()) ++index;
+
+            job = std::move(queues[index].front());
+            queues[index].pop_front();
+
+            JobClassStats& stats = counters[index];
+            const float wait_ms = elapsedMs(job.enqueued, std::chrono::steady_clock::now());
+            stats.depth = queues[index].size();
+            ++stats.started;
+            stats.total_wait_ms += wait_ms;
+            stats.max_wait_ms = std::max(stats.max_wait_ms, wait_ms);
+        }
+
+        const auto t_start = std::chrono::steady_clock::now();
+        try
+        {
+            job.run();
+        }
+        catch (const std::exception& ex)
+        {
+            std::cerr << "[EXECUTOR] " << jobClassName(static_cast<JobClass>(index)) << " job failed: " << ex.what() << std::endl;
+        }
+        catch (...)
+        {
+            std::cerr << "[EXECUTOR] " << jobClassName(static_cast<JobClass>(index)) << " job failed." << std::endl;
+        }
+        const float run_ms = elapsedMs(t_start, std::chrono::steady_clock::now());
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            JobClassStats& stats = counters[index];
+            ++stats.completed;
+            stats.total_run_ms += run_ms;
+            stats.max_run_ms = std::max(stats.max_run_ms, run_ms);
+        }
+    }
+}
+
+// === Total queued jobs ===
+size_t InferenceExecutor::queuedCount() const
+{
+    size_t count = 0;
+    for (const auto& queue : queues) count += queue.size();
+
+    return count;
+}
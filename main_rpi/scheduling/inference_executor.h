@@ -0,0 +1,142 @@
+#ifndef INFERENCE_EXECUTOR_H
+#define INFERENCE_EXECUTOR_H
+
+// Standard Library
+#include <array>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+#include <string>
+
+// Project headers
+#include "config.h"
+
+/**
+ * @brief Kind of inference job, in priority order (lower value runs first).
+ */
+enum class JobClass
+{
+    Fall = 0,      ///< Fall confirmation and route planning of an incident
+    Periodic = 1   ///< Periodic people count on CH1
+};
+
+constexpr size_t JOB_CLASS_COUNT = 2;
+
+/**
+ * @brief Queue and timing counters of one job class.
+ */
+struct JobClassStats
+{
+    size_t depth = 0;           ///< Jobs currently queued
+    size_t peak_depth = 0;      ///< Largest queue depth seen
+    size_t submitted = 0;       ///< Jobs accepted into the queue
+    size_t coalesced = 0;       ///< Queued jobs replaced by a newer one of the same class
+    size_t evicted = 0;         ///< Queued jobs dropped to make room for a higher class
+    size_t rejected = 0;        ///< Jobs refused because the queue was full
+    size_t started = 0;         ///< Jobs taken by a worker
+    size_t completed = 0;       ///< Jobs that finished running
+    float total_wait_ms = 0.0f; ///< Sum of queue wait times of started jobs
+    float max_wait_ms = 0.0f;   ///< Longest queue wait
+    float total_run_ms = 0.0f;  ///< Sum of run times of completed jobs
+    float max_run_ms = 0.0f;    ///< Longest run time
+
+    float averageWaitMs() const { return started ? total_wait_ms / started : 0.0f; }
+    float averageRunMs() const { return completed ? total_run_ms / completed : 0.0f; }
+};
+
+/**
+ * @brief Fixed pool of inference workers fed by a bounded priority queue.
+ *
+ * Fall jobs always start before queued periodic jobs, and may evict a queued
+ * periodic job when the queue is full. Only one periodic job is kept waiting:
+ * a newer one replaces it, so a backlog never replays stale counts.
+ */
+class InferenceExecutor
+{
+public:
+    /**
+     * @brief Starts the worker threads.
+     * @param Number of workers
+     * @param Maximum number of queued jobs over all classes
+     */
+    explicit InferenceExecutor(size_t worker_count = INFERENCE_WORKER_COUNT, size_t queue_capacity = INFERENCE_QUEUE_CAPACITY);
+
+    /**
+     * @brief Stops the workers, discarding queued jobs.
+     */
+    ~InferenceExecutor();
+
+    InferenceExecutor(const InferenceExecutor&) = delete;
+    InferenceExecutor& operator=(const InferenceExecutor&) = delete;
+
+    /**
+     * @brief Queues a job.
+     * @param Job class
+     * @param Job to run on a worker
+     * @return false if the queue is full or the executor is stopped
+     */
+    bool submit(JobClass job_class, std::function<void()> job);
+
+    /**
+     * @brief Discards queued jobs and waits for running ones to finish.
+     */
+    void stop();
+
+    /**
+     * @brief Returns a snapshot of the counters of one job class.
+     * @param Job class
+     * @return Counters
+     */
+    JobClassStats stats(JobClass job_class) const;
+
+    /**
+     * @brief Prints the counters of every job class.
+     */
+    void printStats() const;
+
+private:
+    /**
+     * @brief A queued job with its enqueue time.
+     */
+    struct Job
+    {
+        std::function<void()> run;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    /**
+     * @brief Worker loop: pops the highest-priority job and runs it.
+     */
+    void workerLoop();
+
+    /**
+     * @brief Total number of queued jobs (caller holds the mutex).
+     */
+    size_t queuedCount() const;
+
+    // === Members ===
+    size_t capacity;
+
+    std::array<std::deque<Job>, JOB_CLASS_COUNT> queues;
+    std::array<JobClassStats, JOB_CLASS_COUNT> counters;
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::thread> workers;
+    bool running;
+};
+
+/**
+ * @brief Returns the lowercase name of a job class
+ * @param Job class
+ * @return "fall" or "periodic"
+ */
+inline const char* jobClassName(JobClass job_class)
+{
+    return job_class == JobClass::Fall ? "fall" : "periodic";
+}
+
+#endif // INFERENCE_EXECUTOR_H
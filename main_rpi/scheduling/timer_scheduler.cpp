@@ -0,0 +1,131 @@
+// Standard Library
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+
+// System Library
+#include <unistd.h>
+#include <sys/timerfd.h>
+
+// Project headers
+#include "timer_scheduler.h"
+
+// === Constructor ===
+TimerScheduler::TimerScheduler()
+    : next_id(1),
+    timer_fd(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)),
+    armed_at(Clock::time_point::max())
+{
+    if (timer_fd < 0)
+        std::cerr << "[TIMER] timerfd_create failed: " << strerror(errno) << std::endl;
+}
+
+// === Destructor ===
+TimerScheduler::~TimerScheduler()
+{
+    if (timer_fd >= 0) close(timer_fd);
+}
+
+// === Schedules a callback at a deadline ===
+TimerId TimerScheduler::schedule(Clock::time_point due, TimerCallback callback, std::chrono::milliseconds period)
+{
+    const TimerId id = next_id++;
+
+    timers.emplace(Key(due, id), Timer{ std::move(callback), period });
+    due_by_id.emplace(id, due);
+
+    if (due < armed_at) rearm();
+
+    return id;
+}
+
+// === Schedules a callback after a delay ===
+TimerId TimerScheduler::scheduleAfter(std::chrono::milliseconds delay, TimerCallback callback, std::chrono::milliseconds period)
+{
+    return schedule(Clock::now() + delay, std::move(callback), period);
+}
+
+// === Removes a pending timer ===
+bool TimerScheduler::cancel(TimerId id)
+{
+    auto it = due_by_id.find(id);
+    if (it == due_by_id.end()) return false;
+
+    const Clock::time_point due = it->second;
+    timers.erase(Key(due, id));
+    due_by_id.erase(it);
+
+    if (due == armed_at) rearm();
+
+    return true;
+}
+
+// === Runs every due callback ===
+size_t TimerScheduler::expire()
+{
+    if (timer_fd >= 0)
+    {
+        uint64_t expirations = 0;
+        [[maybe_unused]] ssize_t read_bytes = read(timer_fd, &expirations, sizeof(expirations));
+    }
+
+    const Clock::time_point now = Clock::now();
+    size_t fired = 0;
+
+    // Take one timer at a time: a callback may schedule or cancel others
+    while (!timers.empty() && timers.begin()->first.first <= now)
+    {
+        auto node = timers.extract(timers.begin());
+        const auto [due, id] = node.key();
+        TimerCallback callback = node.mapped().callback;
+        const std::chrono::milliseconds period = node.mapped().period;
+
+        if (period.count() > 0)
+        {
+            // Keep the phase; skip missed periods instead of firing a burst
+            Clock::time_point next = due + period;
+            if (next <= now) next = now + period;
+
+            node.key() = Key(next, id);
+            timers.insert(std::move(node));
+            due_by_id[id] = next;
+        }
+        else
+        {
+            due_by_id.erase(id);
+        }
+
+        callback();
+        ++fired;
+    }
+
+    rearm();
+
+    return fired;
+}
+
+// === Returns the earliest deadline ===
+TimerScheduler::Clock::time_point TimerScheduler::nextDue() const
+{
+    return timers.empty() ? Clock::time_point::max() : timers.begin()->first.first;
+}
+
+// === Arms the timerfd at the earliest deadline ===
+void TimerScheduler::rearm()
+{
+    armed_at = nextDue();
+    if (timer_fd < 0) return;
+
+    itimerspec spec{};
+    if (!timers.empty())
+    {
+        // steady_clock counts from the CLOCK_MONOTONIC epoch; a zero value would disarm
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(armed_at.time_since_epoch()).count();
+        const long long absolute_ns = ns > 0 ? ns : 1;
+        spec.it_value.tv_sec = static_cast<time_t>(absolute_ns / 1000000000LL);
+        spec.it_value.tv_nsec = static_cast<long>(absolute_ns % 1000000000LL);
+    }
+
+    if (timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr) < 0)
+        std::cerr << "[TIMER] timerfd_settime failed: " << strerror(errno) << std::endl;
+}
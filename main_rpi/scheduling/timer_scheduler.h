@@ -0,0 +1,118 @@
+#ifndef TIMER_SCHEDULER_H
+#define TIMER_SCHEDULER_H
+
+// Standard Library
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Identifies a scheduled timer; 0 is never used.
+ */
+using TimerId = uint64_t;
+
+/**
+ * @brief Called when a timer is due.
+ */
+using TimerCallback = std::function<void()>;
+
+/**
+ * @brief One-thread deadline scheduler on a monotonic timerfd.
+ *
+ * Timers are kept in deadline order and the timerfd is armed at the earliest
+ * one, so the owner can poll fd() next to its other descriptors and sleep
+ * until exactly the next deadline, or indefinitely when nothing is scheduled.
+ * Deadlines are std::chrono::steady_clock time points, which is
+ * CLOCK_MONOTONIC on Linux and unaffected by wall-clock changes.
+ *
+ * Not thread-safe: schedule(), cancel() and expire() are called on the owner's
+ * thread, and callbacks run there from expire().
+ */
+class TimerScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Creates the timerfd.
+     */
+    TimerScheduler();
+
+    /**
+     * @brief Closes the timerfd.
+     */
+    ~TimerScheduler();
+
+    TimerScheduler(const TimerScheduler&) = delete;
+    TimerScheduler& operator=(const TimerScheduler&) = delete;
+
+    /**
+     * @brief Schedules a callback at a deadline.
+     * @param Deadline
+     * @param Callback
+     * @param Repeat period (zero for a one-shot timer)
+     * @return Timer id for cancel()
+     */
+    TimerId schedule(Clock::time_point due, TimerCallback callback,
+        std::chrono::milliseconds period = std::chrono::milliseconds(0));
+
+    /**
+     * @brief Schedules a callback after a delay.
+     */
+    TimerId scheduleAfter(std::chrono::milliseconds delay, TimerCallback callback,
+        std::chrono::milliseconds period = std::chrono::milliseconds(0));
+
+    /**
+     * @brief Removes a timer that has not fired yet (or a repeating one).
+     * @param Timer id (0 is ignored)
+     * @return false if the timer was not pending
+     */
+    bool cancel(TimerId id);
+
+    /**
+     * @brief Runs the callbacks of every timer due by now and re-arms the timerfd.
+     * @return Number of callbacks run
+     */
+    size_t expire();
+
+    /**
+     * @brief Returns the earliest deadline, or Clock::time_point::max() if none.
+     */
+    Clock::time_point nextDue() const;
+
+    /**
+     * @brief Returns the number of pending timers.
+     */
+    size_t size() const { return timers.size(); }
+
+    /**
+     * @brief Returns the timerfd, readable once the earliest deadline has passed.
+     */
+    int fd() const { return timer_fd; }
+
+private:
+    struct Timer
+    {
+        TimerCallback callback;
+        std::chrono::milliseconds period;
+    };
+
+    using Key = std::pair<Clock::time_point, TimerId>;
+
+    /**
+     * @brief Arms the timerfd at the earliest deadline, or disarms it.
+     */
+    void rearm();
+
+    // === Members ===
+    std::map<Key, Timer> timers;                         ///< Pending timers in deadline order
+    std::unordered_map<TimerId, Clock::time_point> due_by_id;
+    TimerId next_id;
+    int timer_fd;
+    Clock::time_point armed_at;                          ///< Deadline the timerfd is set to
+};
+
+#endif // TIMER_SCHEDULER_H
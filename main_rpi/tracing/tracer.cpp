@@ -0,0 +1,257 @@
+// Standard Library
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+// Project headers
+#include "tracer.h"
+
+// === Samples of one thread ===
+// Single producer (the owning thread), single consumer (collect() under the tracer mutex)
+class TraceRing {
+public:
+    struct Sample {
+        TraceStage stage;
+        uint64_t duration_us;
+    };
+
+    bool push(const Sample& sample) {
+        const size_t head = write_index.load(std::memory_order_relaxed);
+        if (head - read_index.load(std::memory_order_acquire) >= TRACE_RING_CAPACITY) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        samples[head % TRACE_RING_CAPACITY] = sample;
+        write_index.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    template <typename Sink>
+    void drain(Sink&& sink) {
+        const size_t head = write_index.load(std::memory_order_acquire);
+        size_t tail = read_index.load(std::memory_order_relaxed);
+
+        for (; tail != head; ++tail) sink(samples[tail % TRACE_RING_CAPACITY]);
+
+        read_index.store(tail, std::memory_order_release);
+    }
+
+    uint64_t takeDropped() { return dropped.exchange(0, std::memory_order_relaxed); }
+
+    bool empty() const {
+        return write_index.load(std::memory_order_acquire) == read_index.load(std::memory_order_acquire);
+    }
+
+private:
+    std::array<Sample, TRACE_RING_CAPACITY> samples;
+    std::atomic<size_t> write_index{ 0 };
+    std::atomic<size_t> read_index{ 0 };
+    std::atomic<uint64_t> dropped{ 0 };
+};
+
+// === Stage Names ===
+const char* traceStageName(TraceStage stage) {
+    switch (stage) {
+    case TraceStage::TriggerToImage: return "trigger_to_image";
+    case TraceStage::Decode: return "decode";
+    case TraceStage::Preprocess: return "preprocess";
+    case TraceStage::Inference: return "inference";
+    case TraceStage::TensorDecode: return "tensor_decode";
+    case TraceStage::Nms: return "nms";
+    case TraceStage::PeopleCount: return "people_count";
+    case TraceStage::Congestion: return "congestion";
+    case TraceStage::PathSearch: return "path_search";
+    case TraceStage::Render: return "render";
+    case TraceStage::Encode: return "encode";
+    case TraceStage::Publish: return "publish";
+    case TraceStage::TriggerToPublish: return "trigger_to_publish";
+    }
+    return "unknown";
+}
+
+// === Bucket of a value ===
+size_t LatencyHistogram::bucketIndex(uint64_t value) {
+    constexpr uint64_t sub_bucket_count = 1u << SUB_BUCKET_BITS;
+    constexpr uint64_t half_count = sub_bucket_count / 2;
+
+    if (value < sub_bucket_count) return static_cast<size_t>(value);
+
+    const int magnitude = 63 - __builtin_clzll(value);
+    if (magnitude >= MAX_MAGNITUDE) return BUCKET_COUNT - 1;
+
+    // The top SUB_BUCKET_BITS bits of the value pick one of 16 buckets within its power of two
+    const int shift = magnitude - (SUB_BUCKET_BITS - 1);
+    const uint64_t sub_bucket = (value >> shift) - half_count;
+
+    return static_cast<size_t>(sub_bucket_count + (magnitude - SUB_BUCKET_BITS) * half_count + sub_bucket);
+}
+
+// === Largest value of a bucket ===
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    constexpr size_t sub_bucket_count = 1u << SUB_BUCKET_BITS;
+    constexpr size_t half_count = sub_bucket_count / 2;
+
+    if (index < sub_bucket_count) return index;
+
+    const size_t offset = index - sub_bucket_count;
+    const int shift = static_cast<int>(offset / half_count) + 1;
+    const uint64_t sub_bucket = offset % half_count + half_count;
+
+    return ((sub_bucket + 1) << shift) - 1;
+}
+
+// === Adds one sample ===
+void LatencyHistogram::record(uint64_t value_us) {
+    ++buckets[bucketIndex(value_us)];
+    ++total;
+    sum += value_us;
+    min_value = std::min(min_value, value_us);
+    max_value = std::max(max_value, value_us);
+}
+
+// === Adds another histogram ===
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) buckets[i] += other.buckets[i];
+
+    total += other.total;
+    sum += other.sum;
+    min_value = std::min(min_value, other.min_value);
+    max_value = std::max(max_value, other.max_value);
+}
+
+// === Clears all samples ===
+void LatencyHistogram::reset() {
+    buckets.fill(0);
+    total = 0;
+    sum = 0;
+    min_value = UINT64_MAX;
+    max_value = 0;
+}
+
+// === Value at a percentile ===
+uint64_t LatencyHistogram::percentile(double percent) const {
+    if (total == 0) return 0;
+
+    const double clamped = std::min(100.0, std::max(0.0, percent));
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(total))));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets[i];
+        if (seen < rank) continue;
+
+        // The last bucket is open-ended
+        return (i == BUCKET_COUNT - 1) ? max_value : std::min(bucketUpperBound(i), max_value);
+    }
+
+    return max_value;
+}
+
+// === Destructor ===
+Tracer::~Tracer() = default;
+
+// === Ring of the calling thread ===
+TraceRing& Tracer::localRing() {
+    // The tracer keeps a reference too, so samples of an exited thread are still collected
+    thread_local std::shared_ptr<TraceRing> ring;
+
+    if (!ring) {
+        ring = std::make_shared<TraceRing>();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        rings.push_back(ring);
+    }
+
+    return *ring;
+}
+
+// === Records one sample ===
+void Tracer::record(TraceStage stage, std::chrono::steady_clock::duration elapsed) {
+    if (!TRACE_ENABLED) return;
+
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    localRing().push({ stage, static_cast<uint64_t>(std::max<int64_t>(0, us)) });
+}
+
+// === Drains every ring into the histograms ===
+void Tracer::collect() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (const auto& ring : rings) {
+        ring->drain([this](const TraceRing::Sample& sample) {
+            histograms[static_cast<size_t>(sample.stage)].record(sample.duration_us);
+            });
+        dropped += ring->takeDropped();
+    }
+
+    // Rings only the tracer still holds belong to threads that have exited
+    rings.erase(std::remove_if(rings.begin(), rings.end(), [](const std::shared_ptr<TraceRing>& ring) {
+        return ring.use_count() == 1 && ring->empty();
+        }), rings.end());
+}
+
+// === Copy of one stage histogram ===
+LatencyHistogram Tracer::histogram(TraceStage stage) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return histograms[static_cast<size_t>(stage)];
+}
+
+// === JSON report ===
+std::string Tracer::report(const std::string& source) const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const auto ms = [](uint64_t us) { return static_cast<double>(us) / 1000.0; };
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3);
+    out << "{\"source\":\"" << source << "\",\"dropped\":" << dropped << ",\"stages\":{";
+
+    bool first = true;
+    for (size_t i = 0; i < TRACE_STAGE_COUNT; ++i) {
+        const LatencyHistogram& h = histograms[i];
+        if (h.count() == 0) continue;
+
+        if (!first) out << ",";
+        first = false;
+
+        out << "\"" << traceStageName(static_cast<TraceStage>(i)) << "\":{"
+            << "\"count\":" << h.count()
+            << ",\"mean_ms\":" << h.mean() / 1000.0
+            << ",\"p50_ms\":" << ms(h.percentile(50.0))
+            << ",\"p90_ms\":" << ms(h.percentile(90.0))
+            << ",\"p99_ms\":" << ms(h.percentile(99.0))
+            << ",\"max_ms\":" << ms(h.max()) << "}";
+    }
+
+    out << "}}";
+
+    return out.str();
+}
+
+// === Writes the report to a file ===
+bool Tracer::dumpToFile(const std::string& path, const std::string& source) const {
+    std::ofstream output(path, std::ios::trunc);
+    if (!output) return false;
+
+    output << report(source) << std::endl;
+
+    return static_cast<bool>(output);
+}
+
+// === Clears the histograms ===
+void Tracer::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto& h : histograms) h.reset();
+    dropped = 0;
+}
+
+// === Process-wide Tracer ===
+Tracer& tracer() {
+    static Tracer instance;
+    return instance;
+}
@@ -16,6 +16,13 @@
 #include <QTextStream>
 #include <QDir>
 #include <QStandardPaths>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr int kMaxLatencySamples = 1000;
+constexpr qint64 kMaxFallAlertAgeMs = 120000;  // Alerts the server ignored or failed never get an image
+}
 
 Mqtt::Mqtt(QWidget *parent)
     : QWidget(parent)
@@ -130,7 +137,8 @@ void Mqtt::onConnected()
     qDebug() << "[MQTT] Successfully connected to broker";
     logTextEdit->append("MQTT 연결 성공!");
 
-    QStringList topics = { "pop/1", "pop/2", "pop/3", "pi/data/fall", "main/result/log/", "main/result/image/", "main/data/Count" };
+    QStringList topics = { "pop/1", "pop/2", "pop/3", "pi/data/fall", "main/result/log/", "main/result/image/", "main/data/Count",
+                           "main/diag/trace", "sub/diag/trace/+" };
     for (const QString& topic : topics) {
         auto sub = m_client->subscribe(topic, 1);
         if (!sub)
@@ -211,6 +219,9 @@ void Mqtt::onMessageReceived(const QByteArray &message, const QMqttTopicName &to
     // }
     // 🔥 Fall Detection 메시지 처리
     if (topic.name() == "pi/data/fall") {
+        QElapsedTimer alertTimer;
+        alertTimer.start();
+        m_fallAlertTimers.enqueue(alertTimer);
         qDebug() << "[MQTT] :느낌표: Fall detection message received:" << payloadStr;
         logTextEdit->append(QString(":느낌표:Fall Detected from: %1").arg(topic.name()));
         if (m_monitorWindow) {
@@ -283,10 +294,15 @@ void Mqtt::onMessageReceived(const QByteArray &message, const QMqttTopicName &to
         q.addBindValue(jsonStr);
         q.exec();
 
+        m_resultRerouted = QJsonDocument::fromJson(message).object().value("rerouted").toBool();
+
         qDebug() << "[main/result/log] Stored JSON for" << eventTime << ":" << jsonStr;
     }
 
     if (topic.name() == "main/result/image/") {
+        QElapsedTimer storeTimer;
+        storeTimer.start();
+
         QString eventTime = QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss");
         qDebug() << "[ImageEventTime] " << eventTime;
 
@@ -349,7 +365,19 @@ void Mqtt::onMessageReceived(const QByteArray &message, const QMqttTopicName &to
             }, Qt::QueuedConnection);
         }
 
-        qDebug() << "[Mqtt] Image saved and DB entry created for" << eventTime;
+        qDebug() << "[Mqtt] Image saved and DB entry created for" << eventTime << "in" << storeTimer.elapsed() << "ms";
+
+        // Incidents are published in alert order; a re-routed result was already timed
+        while (!m_fallAlertTimers.isEmpty() && m_fallAlertTimers.head().elapsed() > kMaxFallAlertAgeMs)
+            m_fallAlertTimers.dequeue();
+        if (!m_resultRerouted && !m_fallAlertTimers.isEmpty())
+            recordFallToResult(m_fallAlertTimers.dequeue().elapsed());
+        m_resultRerouted = false;
+    }
+
+    // 서버 단계별 지연 리포트 (main/diag/trace, sub/diag/trace/<id>)
+    if (topic.name() == "main/diag/trace" || topic.name().startsWith("sub/diag/trace/")) {
+        qDebug() << "[TRACE]" << topic.name() << payloadStr;
     }
 
     // 👇 이하 기존 사람 수 crowd count 처리
@@ -383,6 +411,25 @@ void Mqtt::onMessageReceived(const QByteArray &message, const QMqttTopicName &to
     }
 }
 
+void Mqtt::recordFallToResult(qint64 elapsedMs)
+{
+    m_fallToResultMs.append(elapsedMs);
+    if (m_fallToResultMs.size() > kMaxLatencySamples)
+        m_fallToResultMs.removeFirst();
+
+    QVector<qint64> sorted = m_fallToResultMs;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](double p) {
+        const int rank = qMax(1, static_cast<int>(std::ceil(p / 100.0 * sorted.size())));
+        return sorted[rank - 1];
+    };
+
+    const QString line = QString("[TRACE] fall alert -> result: %1 ms (p50 %2 ms, p99 %3 ms, %4 incidents)")
+                             .arg(elapsedMs).arg(percentile(50.0)).arg(percentile(99.0)).arg(sorted.size());
+    qDebug() << line;
+    logTextEdit->append(line);
+}
+
 bool Mqtt::publishMessage(const QString &topic, const QByteArray &payload, quint8 qos, bool retain)
 {
     if (!m_client || m_client->state() != QMqttClient::Connected) {
@@ -395,6 +442,10 @@ bool Mqtt::publishMessage(const QString &topic, const QByteArray &payload, quint
         return false;
     }
     qDebug() << "[MQTT] Publish 성공:" << topic << payload;
+
+    // The off order cancels every open incident on the server; none of them will send a result
+    if (topic == "qt/off")
+        m_fallAlertTimers.clear();
     return true;
 }
 
@@ -4,6 +4,9 @@
 #include <QWidget>
 #include <QtMqtt/QMqttClient>
 #include <QSqlDatabase>
+#include <QElapsedTimer>
+#include <QQueue>
+#include <QVector>
 #include "monitorwindow.h"
 
 class QTextEdit;
@@ -30,10 +33,15 @@ private Q_SLOTS:
     void onErrorChanged(QMqttClient::ClientError error);
 
 private:
+    void recordFallToResult(qint64 elapsedMs);
+
     QMqttClient *m_client;
     QSqlDatabase m_db;
     QTextEdit *logTextEdit;
     MonitorWindow* m_monitorWindow = nullptr;
+    QQueue<QElapsedTimer> m_fallAlertTimers;  // One per pi/data/fall, oldest first; the incident's first result image takes one
+    bool m_resultRerouted = false;            // Last result log was a re-route, so its image closes no alert
+    QVector<qint64> m_fallToResultMs;   // Fall alert to result shown, most recent incidents
 };
 
 #endif // MQTT_H
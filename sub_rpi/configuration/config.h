@@ -1,40 +1,182 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
+// Standard Library
+#include <string>
+
 // OpenCV
 #include <opencv2/opencv.hpp>
 
+// Model Precision
+enum class ModelPrecision { FP32, FP16, INT8 };
+
+// JPEG Codec Backend
+enum class JpegBackend { OpenCV, TurboJpeg };
+
+// Input Size Selection
+enum class InputSizeMode { Fixed, Occupancy, LatencyBudget };
+
 // YOLO Input
 constexpr int YOLO_INPUT_WIDTH = 640;
 constexpr int YOLO_INPUT_HEIGHT = 640;
-constexpr int INPUT_LONG_SIDE_TARGET = 640;
+
+// Adaptive Input Resolution (square sizes, multiples of 32; dynamic-shape models only)
+constexpr int YOLO_INPUT_SIZES[] = { 320, 416, 640 };
+constexpr InputSizeMode FALL_INPUT_SIZE_MODE = InputSizeMode::Occupancy;
+constexpr InputSizeMode CROWD_INPUT_SIZE_MODE = InputSizeMode::Occupancy;
+constexpr int INPUT_SIZE_OCCUPANCY_LOW = 4;
+constexpr int INPUT_SIZE_OCCUPANCY_HIGH = 12;
+constexpr float INPUT_SIZE_LATENCY_BUDGET_MS = 120.0f;
+constexpr bool PERIODIC_COUNT_ADAPTIVE_INPUT = false;  // periodic counts follow the size policy; they are published, so off until benched
 
 // Fall Detection Model
 constexpr const char* FALL_MODEL_PATH = "fall.onnx";
 constexpr float FALL_CONF_THRESHOLD = 0.3125f;
 constexpr int FALL_PERSON_CLASS_ID = 0;
+constexpr ModelPrecision FALL_MODEL_PRECISION = ModelPrecision::FP32;
 
 // Crowd Detection Model
 constexpr const char* CROWD_MODEL_PATH = "crowd.onnx";
 constexpr float CROWD_CONF_THRESHOLD = 0.25f;
+constexpr ModelPrecision CROWD_MODEL_PRECISION = ModelPrecision::FP32;
 constexpr float NMS_THRESHOLD = 0.4375f;
 
+// Tiled Inference (high-resolution frames; tiles run at native resolution)
+constexpr bool FALL_TILED_INFERENCE = false;
+constexpr bool CROWD_TILED_INFERENCE = false;
+constexpr int TILE_SIZE = 640;
+constexpr float TILE_OVERLAP = 0.25f;
+constexpr bool TILE_INCLUDE_FULL_FRAME = true;
+constexpr float TILE_MERGE_THRESHOLD = 0.6f;
+
+// Batched Inference ("fall.onnx" -> "fall.batch.onnx", exported with a dynamic batch axis)
+constexpr int YOLO_MAX_BATCH_SIZE = 4;
+
+// ONNX Runtime (one global thread pool shared by all sessions)
+constexpr int ORT_INTRA_OP_THREADS = 4;
+constexpr bool ORT_ALLOW_SPINNING = false;
+
+// Inference Executor (main server; jobs also share the ORT pool above)
+constexpr size_t INFERENCE_WORKER_COUNT = 2;
+constexpr size_t INFERENCE_QUEUE_CAPACITY = 8;
+
+// JPEG Codec (TurboJPEG is used when built with HAVE_TURBOJPEG, OpenCV otherwise)
+constexpr JpegBackend JPEG_BACKEND = JpegBackend::TurboJpeg;
+constexpr int JPEG_QUALITY = 90;
+constexpr bool JPEG_PROGRESSIVE = false;
+constexpr bool JPEG_SCALED_DECODE = true;
+
+// Incident Handling (main server)
+constexpr size_t SUB_CAMERA_COUNT = 3;
+constexpr int CAPTURE_TIMEOUT_MS = 60000;
+constexpr int SUB_COUNT_TIMEOUT_MS = 5000;
+constexpr float SUB_COUNT_HALF_LIFE_MS = 120000.0f;
+constexpr int SUB_COUNT_LATE_WINDOW_MS = 20000;
+constexpr int INCIDENT_TIMEOUT_MS = 60000;
+constexpr int LED_ON_DURATION_MS = 60000;
+constexpr size_t MAX_CONCURRENT_INCIDENTS = 4;
+
+// Capture Ingest (FTP receiver, main server)
+constexpr int FTP_INGEST_PORT = 2121;
+constexpr size_t INGEST_MAX_CLIENTS = 8;
+constexpr int INGEST_IDLE_TIMEOUT_MS = 60000;
+
+// Archive Writer (result images, captures and logs written after the response)
+constexpr size_t ARCHIVE_JOBS_PER_INCIDENT = 8;   // Capture, result.jpg, path.jpg, log, summary; a re-route adds path.jpg, log, summary
+constexpr size_t ARCHIVE_DIAGNOSTIC_JOBS = 4;
+constexpr size_t ARCHIVE_QUEUE_CAPACITY = MAX_CONCURRENT_INCIDENTS * ARCHIVE_JOBS_PER_INCIDENT + ARCHIVE_DIAGNOSTIC_JOBS;
+
+// Tracing (per-stage latency histograms, dumped every TRACE_DUMP_INTERVAL_MS)
+constexpr bool TRACE_ENABLED = true;
+constexpr size_t TRACE_RING_CAPACITY = 4096;
+constexpr int TRACE_DUMP_INTERVAL_MS = 60000;
+constexpr const char* TRACE_DUMP_PATH = "./log/trace.json";
+
+// Replay (main server --replay): how long a recorded image waits for its capture rule to be armed
+constexpr int REPLAY_CLAIM_TIMEOUT_MS = 2000;
+
 // Grid & Congestion
 constexpr int GRID_CELL_SIZE = 20;
 constexpr float CONGESTION_DECAY_ALPHA = 0.0625f;
 constexpr int CONGESTION_INFLUENCE_RADIUS = 2;
+constexpr int CONGESTION_CONVOLVE_MIN_PEOPLE = 128;    // from this many people, count per cell and convolve instead of stamping each
+constexpr int CONGESTION_MODEL_TIME_CONSTANT_MS = 30000;   // rolling congestion model: an observation this old weighs 1/e
+constexpr int CONGESTION_MODEL_MAX_AGE_MS = 120000;       // beyond this since the last observation, routing uses the fall frame alone
 
 // Pathfinding Parameters
 constexpr float PATH_ALPHA_HIGH = 0.625f;
 constexpr float PATH_ALPHA_LOW = 0.25f;
 constexpr float PATH_EXIT_OUTER_WEIGHT = 0.625f;
 constexpr float PATH_INNER_CONGESTION_THRESHOLD = 5.0f;
+constexpr int PATH_SWEEP_MIN_GOALS = 12;   // from this many exits, one Dijkstra sweep beats one A* per exit (bench_pathfinding)
 
 // Rendering
 constexpr float RENDERER_HEATMAP_ALPHA = 0.625f;
 constexpr float RENDERER_HEATMAP_GAMMA = 0.5f;
 constexpr int RENDERER_HEATMAP_BLUR = 9;
 
+/**
+ * @brief Returns the lowercase name of a model precision
+ * @param Model precision
+ * @return "fp32", "fp16" or "int8"
+ */
+inline const char* modelPrecisionName(ModelPrecision precision) {
+    switch (precision) {
+    case ModelPrecision::FP16: return "fp16";
+    case ModelPrecision::INT8: return "int8";
+    default: return "fp32";
+    }
+}
+
+/**
+ * @brief Parses a precision name ("fp32", "fp16", "int8")
+ * @param Precision name
+ * @param Parsed precision
+ * @return True if the name is valid
+ */
+inline bool parseModelPrecision(const std::string& name, ModelPrecision& precision) {
+    if (name == "fp32") precision = ModelPrecision::FP32;
+    else if (name == "fp16") precision = ModelPrecision::FP16;
+    else if (name == "int8") precision = ModelPrecision::INT8;
+    else return false;
+
+    return true;
+}
+
+/**
+ * @brief Inserts a variant tag before the ".onnx" extension ("fall.onnx" -> "fall.int8.onnx")
+ * @param Model path
+ * @param Variant tag
+ * @return Path of the variant
+ */
+inline std::string modelVariantPath(const std::string& model_path, const std::string& tag) {
+    const size_t dot = model_path.rfind(".onnx");
+    const std::string stem = (dot == std::string::npos) ? model_path : model_path.substr(0, dot);
+
+    return stem + "." + tag + ".onnx";
+}
+
+/**
+ * @brief Derives the model file for a precision ("fall.onnx" -> "fall.int8.onnx")
+ * @param FP32 model path
+ * @param Model precision
+ * @return Path of the quantized variant, or the FP32 path itself
+ */
+inline std::string modelPathForPrecision(const std::string& fp32_path, ModelPrecision precision) {
+    if (precision == ModelPrecision::FP32) return fp32_path;
+
+    return modelVariantPath(fp32_path, modelPrecisionName(precision));
+}
+
+/**
+ * @brief Derives the batch-dynamic export of a model ("fall.int8.onnx" -> "fall.int8.batch.onnx")
+ * @param Model path
+ * @return Path of the batch-dynamic variant
+ */
+inline std::string modelPathForBatch(const std::string& model_path) {
+    return modelVariantPath(model_path, "batch");
+}
+
 /**
  * @brief Converts pixel coordinates to grid coordinates
  * @param Pixel point
@@ -71,25 +213,26 @@ inline cv::Point toPixelOrigin(const cv::Point& grid_pt) {
  * @param Scale factor used
  * @param Top padding in pixels
  * @param Left padding in pixels
+ * @param Square model input size
  * @return Letterboxed image
  */
-inline cv::Mat letterbox(const cv::Mat& src, float& scale, int& top, int& left) {
+inline cv::Mat letterbox(const cv::Mat& src, float& scale, int& top, int& left, int input_size = YOLO_INPUT_WIDTH) {
     int src_w = src.cols;
     int src_h = src.rows;
 
     float long_side = static_cast<float>(std::max(src_w, src_h));
-    scale = static_cast<float>(INPUT_LONG_SIDE_TARGET) / long_side;
+    scale = static_cast<float>(input_size) / long_side;
 
     int new_w = static_cast<int>(src_w * scale);
     int new_h = static_cast<int>(src_h * scale);
 
-    left = (YOLO_INPUT_WIDTH - new_w) / 2;
-    top = (YOLO_INPUT_HEIGHT - new_h) / 2;
+    left = (input_size - new_w) / 2;
+    top = (input_size - new_h) / 2;
 
     cv::Mat resized;
     cv::resize(src, resized, cv::Size(new_w, new_h));
 
-    cv::Mat padded(YOLO_INPUT_HEIGHT, YOLO_INPUT_WIDTH, src.type(), cv::Scalar(114, 114, 114));
+    cv::Mat padded(input_size, input_size, src.type(), cv::Scalar(114, 114, 114));
     resized.copyTo(padded(cv::Rect(left, top, new_w, new_h)));
 
     return padded;
@@ -0,0 +1,52 @@
+// Standard Library
+#include <algorithm>
+#include <stdexcept>
+
+// Project headers
+#include "input_size_policy.h"
+
+// === Constructor ===
+InputSizePolicy::InputSizePolicy(InputSizeMode mode, const std::vector<int>& sizes)
+    : mode(mode),
+    sizes(sizes) {
+    if (this->sizes.empty()) throw std::invalid_argument("InputSizePolicy needs at least one size.");
+
+    std::sort(this->sizes.begin(), this->sizes.end());
+    index = this->sizes.size() - 1;
+}
+
+// === Size for the Next Frame ===
+int InputSizePolicy::current() const {
+    return sizes[index];
+}
+
+// === Step One Size Up or Down ===
+void InputSizePolicy::update(size_t detection_count, float latency_ms) {
+    const size_t largest = sizes.size() - 1;
+
+    switch (mode) {
+    case InputSizeMode::Occupancy:
+        // Sparse scenes have large, separated people; crowded ones need the resolution
+        if (detection_count >= static_cast<size_t>(INPUT_SIZE_OCCUPANCY_HIGH) && index < largest) ++index;
+        else if (detection_count <= static_cast<size_t>(INPUT_SIZE_OCCUPANCY_LOW) && index > 0) --index;
+        break;
+
+    case InputSizeMode::LatencyBudget: {
+        if (latency_ms > INPUT_SIZE_LATENCY_BUDGET_MS) {
+            if (index > 0) --index;
+            break;
+        }
+
+        // Cost grows with pixel count; only step up if the larger size is expected to fit
+        if (index < largest) {
+            const float ratio = static_cast<float>(sizes[index + 1]) / sizes[index];
+            if (latency_ms * ratio * ratio <= INPUT_SIZE_LATENCY_BUDGET_MS) ++index;
+        }
+        break;
+    }
+
+    default:
+        index = largest;
+        break;
+    }
+}
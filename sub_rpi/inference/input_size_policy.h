@@ -0,0 +1,48 @@
+#ifndef INPUT_SIZE_POLICY_H
+#define INPUT_SIZE_POLICY_H
+
+// Standard Library
+#include <cstddef>
+#include <vector>
+
+// Project headers
+#include "config.h"
+
+/**
+ * @brief Chooses the model input size for the next frame from the last result.
+ *
+ * Sizes are stepped one at a time so a single noisy frame cannot jump from
+ * the smallest to the largest input. The policy starts at the largest size.
+ */
+class InputSizePolicy {
+public:
+    /**
+     * @brief Constructs a policy over a set of input sizes.
+     * @param Selection mode
+     * @param Supported square input sizes
+     */
+    InputSizePolicy(InputSizeMode mode, const std::vector<int>& sizes);
+
+    ~InputSizePolicy() = default;
+
+    /**
+     * @brief Input size to use for the next frame.
+     * @return Square input size in pixels
+     */
+    int current() const;
+
+    /**
+     * @brief Feeds back the outcome of the last frame.
+     * @param Number of detections
+     * @param Inference time in milliseconds
+     */
+    void update(size_t detection_count, float latency_ms);
+
+private:
+    // === Members ===
+    InputSizeMode mode;
+    std::vector<int> sizes;  ///< Ascending
+    size_t index;            ///< Index of the current size
+};
+
+#endif  // INPUT_SIZE_POLICY_H
@@ -0,0 +1,352 @@
+// Standard Library
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+// Project headers
+#include "yolo_engine.h"
+#include "ort_runtime.h"
+#include "config.h"
+
+// === Constructor ===
+YoloEngineBase::YoloEngineBase(const std::string& model_path, const YoloEngineOptions& options)
+    : options(options),
+    size_policy(options.size_mode, { YOLO_INPUT_WIDTH }),
+    batch_preprocessor(YOLO_INPUT_WIDTH, YOLO_INPUT_HEIGHT) {
+    // Try the requested quantized variant first; any failure falls back to the FP32 model
+    if (options.precision != ModelPrecision::FP32) {
+        const std::string variant_path = modelPathForPrecision(model_path, options.precision);
+
+        try {
+            if (!std::ifstream(variant_path).good()) throw std::runtime_error("model file not found: " + variant_path);
+
+            initialize(variant_path);
+            active_precision = options.precision;
+            std::cout << "[" << options.tag << "] Using " << modelPrecisionName(active_precision) << " model: " << variant_path << std::endl;
+
+            initializeBatch(variant_path);
+            return;
+        }
+        catch (const std::exception& e) {
+            std::cerr << "[" << options.tag << "] " << modelPrecisionName(options.precision) << " model unavailable (" << e.what() << "). Falling back to fp32." << std::endl;
+            session = nullptr;
+        }
+    }
+
+    try {
+        initialize(model_path);
+        active_precision = ModelPrecision::FP32;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[" << options.tag << "::" << options.tag << "] Failed to initialize session: " << e.what() << std::endl;
+        session = nullptr;
+        return;
+    }
+
+    initializeBatch(model_path);
+}
+
+// === Session State ===
+bool YoloEngineBase::isReady() const {
+    return static_cast<bool>(session);
+}
+
+// === Active Precision ===
+ModelPrecision YoloEngineBase::activePrecision() const {
+    return active_precision;
+}
+
+// === Batch Support ===
+bool YoloEngineBase::supportsBatch() const {
+    return static_cast<bool>(batch_session);
+}
+
+// === Tiled Inference Settings ===
+void YoloEngineBase::setTiling(const YoloTileOptions& tiling) {
+    std::lock_guard<std::mutex> lock(inference_mutex);
+    options.tiling = tiling;
+}
+
+YoloTileOptions YoloEngineBase::tiling() const {
+    std::lock_guard<std::mutex> lock(inference_mutex);
+    return options.tiling;
+}
+
+// === Overlapping Tile Grid ===
+std::vector<cv::Rect> YoloEngineBase::tileGrid(const cv::Size& image_size, int tile_size, float overlap) {
+    std::vector<cv::Rect> tiles;
+    if (tile_size <= 0 || image_size.width <= 0 || image_size.height <= 0) return tiles;
+
+    const int stride = std::max(1, static_cast<int>(tile_size * (1.0f - std::clamp(overlap, 0.0f, 0.9f))));
+
+    // Start offsets along one axis: the fewest tiles whose overlap is at least the requested one, spread evenly
+    auto offsets = [&](int length) {
+        std::vector<int> starts;
+        if (length <= tile_size) return std::vector<int>{ 0 };
+
+        const int span = length - tile_size;
+        const int count = (span + stride - 1) / stride + 1;
+        for (int i = 0; i < count; ++i) starts.push_back(static_cast<int>(std::lround(static_cast<double>(i) * span / (count - 1))));
+
+        return starts;
+    };
+
+    for (int y : offsets(image_size.height)) {
+        for (int x : offsets(image_size.width)) {
+            tiles.emplace_back(x, y, std::min(tile_size, image_size.width - x), std::min(tile_size, image_size.height - y));
+        }
+    }
+
+    return tiles;
+}
+
+// === Box Reaching an Inner Tile Edge ===
+bool YoloEngineBase::touchesSeam(const cv::Rect& box, const cv::Rect& tile, const cv::Size& image_size) {
+    // Boxes clipped at a seam end on it, give or take the letterbox rounding
+    constexpr int margin = 2;
+
+    return (tile.x > 0 && box.x <= margin)
+        || (tile.y > 0 && box.y <= margin)
+        || (tile.x + tile.width < image_size.width && box.x + box.width >= tile.width - margin)
+        || (tile.y + tile.height < image_size.height && box.y + box.height >= tile.height - margin);
+}
+
+// === Supported Input Sizes ===
+std::vector<int> YoloEngineBase::inputSizes() const {
+    std::vector<int> sizes;
+
+    for (const auto& slot : input_slots) {
+        sizes.push_back(slot.size);
+    }
+
+    return sizes;
+}
+
+// === Open Session, Bind I/O and Run First Inference (throws on failure) ===
+void YoloEngineBase::initialize(const std::string& model_path) {
+    session = OrtRuntime::getSharedSession(model_path);
+
+    // Dynamic spatial axes allow every configured size; a static model runs at its own size only
+    const std::vector<int64_t> model_shape = session->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+    const bool dynamic_size = model_shape.size() == 4 && (model_shape[2] <= 0 || model_shape[3] <= 0);
+
+    input_slots.clear();
+    if (dynamic_size) {
+        for (int size : YOLO_INPUT_SIZES) addInputSlot(size, size);
+    }
+    else {
+        addInputSlot(YOLO_INPUT_WIDTH, YOLO_INPUT_HEIGHT);
+    }
+    active_slot = input_slots.size() - 1;
+
+    bindIo();
+
+    // The warm-up run doubles as a check that every operator of the variant is supported
+    std::lock_guard<std::mutex> lock(inference_mutex);
+    warmUpSlots();
+
+    size_policy = InputSizePolicy(options.size_mode, inputSizes());
+
+    if (dynamic_size) {
+        std::cout << "[" << options.tag << "] Dynamic input size; available sizes:";
+        for (int size : inputSizes()) std::cout << " " << size;
+        std::cout << std::endl;
+    }
+}
+
+// === Allocate Persistent Input for One Size ===
+void YoloEngineBase::addInputSlot(int width, int height) {
+    const std::vector<int64_t> input_shape = { 1, 3, height, width };
+    Ort::AllocatorWithDefaultOptions allocator;
+
+    InputSlot slot{ width, YoloPreprocessor(width, height) };
+    slot.tensor = Ort::Value::CreateTensor<float>(allocator, input_shape.data(), input_shape.size());
+
+    input_slots.push_back(std::move(slot));
+}
+
+// === Bind the Slot for a Requested Size (largest not above it) ===
+void YoloEngineBase::selectInputSlot(int input_size) {
+    size_t index = 0;
+
+    for (size_t i = 0; i < input_slots.size(); ++i) {
+        if (input_slots[i].size <= input_size) index = i;
+    }
+
+    if (index == active_slot) return;
+
+    io_binding.BindInput(input_name.c_str(), input_slots[index].tensor);
+    active_slot = index;
+}
+
+// === Warm Up Every Size, Dropping Smaller Sizes the Model Rejects (caller holds inference_mutex) ===
+void YoloEngineBase::warmUpSlots() {
+    // The full size must work; failures there propagate to the caller
+    for (size_t i = input_slots.size(); i-- > 0;) {
+        const int size = input_slots[i].size;
+        const bool is_full_size = (i == input_slots.size() - 1);
+
+        try {
+            cv::Mat dummy(size, size, CV_8UC3, cv::Scalar(114, 114, 114));
+            float scale;
+            int top, left;
+            runInference(dummy, size, scale, top, left);
+        }
+        catch (const std::exception& e) {
+            if (is_full_size) throw;
+
+            std::cerr << "[" << options.tag << "] Input size " << size << " unsupported (" << e.what() << "); skipped." << std::endl;
+            input_slots.erase(input_slots.begin() + i);
+            active_slot = input_slots.size();  // Force a rebind on the next selection
+        }
+    }
+
+    selectInputSlot(input_slots.back().size);
+}
+
+// === Find a Batch-Dynamic Session (optional; failures leave batching disabled) ===
+void YoloEngineBase::initializeBatch(const std::string& model_path) {
+    auto has_dynamic_batch = [](Ort::Session& s) {
+        const std::vector<int64_t> shape = s.GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+        return !shape.empty() && shape[0] <= 0;
+    };
+
+    try {
+        // A model exported with a dynamic batch axis serves both paths from one session
+        if (has_dynamic_batch(*session)) {
+            batch_session = session;
+        }
+        else {
+            const std::string batch_path = modelPathForBatch(model_path);
+            if (!std::ifstream(batch_path).good()) {
+                std::cout << "[" << options.tag << "] No batch model (" << batch_path << "); batched calls run per image." << std::endl;
+                return;
+            }
+
+            batch_session = OrtRuntime::getSharedSession(batch_path);
+            if (!has_dynamic_batch(*batch_session)) throw std::runtime_error(batch_path + " has a fixed batch axis.");
+        }
+
+        Ort::AllocatorWithDefaultOptions allocator;
+        batch_input_name = batch_session->GetInputNameAllocated(0, allocator).get();
+        batch_output_name = batch_session->GetOutputNameAllocated(0, allocator).get();
+
+        batch_buffer.assign(static_cast<size_t>(YOLO_MAX_BATCH_SIZE) * batch_preprocessor.tensorSize(), 0.0f);
+
+        // Output shape depends on N, so ORT allocates it on each run
+        batch_binding = Ort::IoBinding(*batch_session);
+        batch_binding.BindOutput(batch_output_name.c_str(), Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault));
+
+        std::cout << "[" << options.tag << "] Batched inference enabled (up to " << YOLO_MAX_BATCH_SIZE << " images per call)." << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[" << options.tag << "] Batch model unavailable (" << e.what() << "); batched calls run per image." << std::endl;
+        batch_session = nullptr;
+        batch_buffer.clear();
+    }
+}
+
+// === Warm-up dummy inference ===
+void YoloEngineBase::runWarmUp() {
+    try {
+        if (!session) return;
+
+        std::lock_guard<std::mutex> lock(inference_mutex);
+
+        warmUpSlots();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[" << options.tag << "::runWarmUp] Warm-up failed: " << e.what() << std::endl;
+    }
+}
+
+// === Bind Input/Output Once ===
+void YoloEngineBase::bindIo() {
+    Ort::AllocatorWithDefaultOptions allocator;
+    input_name = session->GetInputNameAllocated(0, allocator).get();
+    output_name = session->GetOutputNameAllocated(0, allocator).get();
+
+    const auto input_info = session->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo();
+    const auto output_info = session->GetOutputTypeInfo(0).GetTensorTypeAndShapeInfo();
+    if (input_info.GetElementType() != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT || output_info.GetElementType() != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
+        throw std::runtime_error("Model input/output must be float32 (export quantized models with float I/O).");
+    }
+
+    io_binding = Ort::IoBinding(*session);
+    io_binding.BindInput(input_name.c_str(), input_slots[active_slot].tensor);
+
+    // Preallocate the output when the model declares a static shape; otherwise let ORT allocate per run
+    // (dynamic spatial axes always give a dynamic output, so the preallocated output never changes size)
+    const std::vector<int64_t> output_shape = output_info.GetShape();
+    const bool is_static = std::all_of(output_shape.begin(), output_shape.end(), [](int64_t d) { return d > 0; });
+
+    if (is_static) {
+        bound_output = Ort::Value::CreateTensor<float>(allocator, output_shape.data(), output_shape.size());
+        io_binding.BindOutput(output_name.c_str(), bound_output);
+    }
+    else {
+        io_binding.BindOutput(output_name.c_str(), Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault));
+    }
+
+    has_static_output = is_static;
+}
+
+// === Preprocess + Run ONNX inference ===
+Ort::Value& YoloEngineBase::runInference(const cv::Mat& image, int input_size, float& scale, int& top, int& left) {
+    if (input_slots.empty()) throw std::runtime_error("Input tensor is not allocated.");
+
+    selectInputSlot(input_size);
+
+    InputSlot& slot = input_slots[active_slot];
+    {
+        TraceSpan span(TraceStage::Preprocess);
+        slot.preprocessor.run(image, slot.tensor.GetTensorMutableData<float>(), scale, top, left);
+    }
+
+    {
+        TraceSpan span(TraceStage::Inference);
+        session->Run(Ort::RunOptions{ nullptr }, io_binding);
+    }
+
+    if (!has_static_output) {
+        std::vector<Ort::Value> outputs = io_binding.GetOutputValues();
+        if (outputs.empty()) throw std::runtime_error("Output tensor is invalid.");
+        bound_output = std::move(outputs[0]);
+    }
+
+    if (!bound_output || !bound_output.IsTensor()) throw std::runtime_error("Output tensor is invalid.");
+
+    return bound_output;
+}
+
+// === Preprocess N Images + Run One Batched Inference ===
+Ort::Value& YoloEngineBase::runBatchInference(const cv::Mat* images, size_t count, std::vector<YoloLetterbox>& letterboxes) {
+    if (count == 0 || count > static_cast<size_t>(YOLO_MAX_BATCH_SIZE)) throw std::runtime_error("Batch size out of range.");
+
+    const size_t plane = batch_preprocessor.tensorSize();
+    letterboxes.resize(count);
+
+    TraceSpan preprocess_span(TraceStage::Preprocess);
+    for (size_t i = 0; i < count; ++i) {
+        batch_preprocessor.run(images[i], batch_buffer.data() + i * plane, letterboxes[i].scale, letterboxes[i].top, letterboxes[i].left);
+    }
+    preprocess_span.stop();
+
+    // Wrap the first N slots of the persistent buffer; no copy is made
+    const std::vector<int64_t> input_shape = { static_cast<int64_t>(count), 3, YOLO_INPUT_HEIGHT, YOLO_INPUT_WIDTH };
+    const Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    batch_input = Ort::Value::CreateTensor<float>(memory_info, batch_buffer.data(), count * plane, input_shape.data(), input_shape.size());
+    batch_binding.BindInput(batch_input_name.c_str(), batch_input);
+
+    {
+        TraceSpan span(TraceStage::Inference);
+        batch_session->Run(Ort::RunOptions{ nullptr }, batch_binding);
+    }
+
+    std::vector<Ort::Value> outputs = batch_binding.GetOutputValues();
+    if (outputs.empty() || !outputs[0].IsTensor()) throw std::runtime_error("Output tensor is invalid.");
+    batch_output = std::move(outputs[0]);
+
+    return batch_output;
+}
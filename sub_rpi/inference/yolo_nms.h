@@ -0,0 +1,71 @@
+#ifndef YOLO_NMS_H
+#define YOLO_NMS_H
+
+// Standard Library
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// OpenCV
+#include <opencv2/core.hpp>
+
+// Project headers
+#include "yolo_simd.h"
+
+/**
+ * @brief Greedy score-sorted NMS with a vectorized overlap sweep.
+ *
+ * Boxes are gathered into score order as separate coordinate arrays, so each
+ * kept box is compared against the remaining candidates four at a time.
+ * Scratch buffers are kept between calls.
+ */
+class YoloNms {
+public:
+    YoloNms() = default;
+    ~YoloNms() = default;
+
+    /**
+     * @brief Runs NMS over candidate boxes
+     * @param Candidate boxes
+     * @param Candidate scores
+     * @param Overlap above which lower-scored boxes are suppressed
+     * @param Overlap measure
+     * @return Indices of kept boxes, highest score first (valid until the next call)
+     */
+    const std::vector<int>& run(const std::vector<cv::Rect>& boxes, const std::vector<float>& scores, float threshold,
+        OverlapMetric metric = OverlapMetric::IoU);
+
+    /**
+     * @brief Merges detections gathered from overlapping views (tiles and the full frame)
+     *
+     * Each view already went through run(), so only boxes of the same class
+     * from different views are compared. A pair where either box touches a
+     * tile seam is compared by intersection over the smaller box, since the cut
+     * box lies inside the whole one; other pairs by IoU.
+     *
+     * @param Candidate boxes
+     * @param Candidate scores
+     * @param Candidate classes
+     * @param View of each candidate
+     * @param Whether each candidate touches a seam of its tile
+     * @param IoU above which lower-scored duplicates are suppressed
+     * @param IoS above which lower-scored duplicates at a seam are suppressed
+     * @return Indices of kept boxes, highest score first (valid until the next call)
+     */
+    const std::vector<int>& runViewMerge(const std::vector<cv::Rect>& boxes, const std::vector<float>& scores, const std::vector<int>& class_ids,
+        const std::vector<int>& views, const std::vector<uint8_t>& on_seam, float iou_threshold, float ios_threshold);
+
+private:
+    /**
+     * @brief Fills order with (score, index), score descending then index ascending
+     */
+    void sortByScore(const std::vector<float>& scores);
+
+    // === Scratch ===
+    std::vector<std::pair<float, int>> order;  ///< (score, index), score descending then index ascending
+    std::vector<float> x1, y1, x2, y2, area;   ///< Boxes in sorted order
+    std::vector<uint8_t> suppressed;
+    std::vector<int> keep;
+};
+
+#endif  // YOLO_NMS_H
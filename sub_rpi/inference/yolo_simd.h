@@ -0,0 +1,55 @@
+#ifndef YOLO_SIMD_H
+#define YOLO_SIMD_H
+
+// Standard Library
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Box overlap measure used for suppression.
+ */
+enum class OverlapMetric {
+    IoU,  ///< Intersection over union
+    IoS   ///< Intersection over the smaller box (merges boxes cut at tile borders)
+};
+
+/**
+ * @brief Element-wise running maximum: dst[i] = max(dst[i], src[i])
+ * @param Destination (and first operand)
+ * @param Second operand
+ * @param Number of elements
+ */
+void simdMaxInPlace(float* dst, const float* src, size_t count);
+
+/**
+ * @brief Collects the indices of scores strictly above a threshold, in ascending order
+ * @param Scores
+ * @param Number of scores
+ * @param Threshold
+ * @param Output indices (room for count entries)
+ * @return Number of indices written
+ */
+size_t simdSelectAbove(const float* scores, size_t count, float threshold, uint32_t* indices);
+
+/**
+ * @brief Marks boxes [begin, end) whose overlap with box ref exceeds the threshold
+ *
+ * Boxes are given as separate x1/y1/x2/y2/area arrays. The IoU matches the
+ * integer cv::Rect computation used before: inter / (union + 1e-6).
+ *
+ * @param Left edges
+ * @param Top edges
+ * @param Right edges (exclusive)
+ * @param Bottom edges (exclusive)
+ * @param Box areas
+ * @param First box to test
+ * @param One past the last box to test
+ * @param Reference box index
+ * @param Overlap threshold
+ * @param Overlap measure
+ * @param Suppression flags (set to 1, never cleared)
+ */
+void simdSuppressOverlaps(const float* x1, const float* y1, const float* x2, const float* y2, const float* area,
+    size_t begin, size_t end, size_t ref, float threshold, OverlapMetric metric, uint8_t* suppressed);
+
+#endif  // YOLO_SIMD_H
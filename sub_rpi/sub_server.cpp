@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <atomic>
+#include <cctype>
 #include <csignal>
 #include <fstream>
 #include <glib-unix.h>
@@ -11,6 +13,7 @@
 #include <opencv2/opencv.hpp>
 #include <thread>
 #include "crowd_detector.h"
+#include "tracer.h"
 
 #define CERT_FILE "/opt/rtsp/server.cert.pem"
 #define KEY_FILE "/opt/rtsp/server.key.pem"
@@ -26,6 +29,8 @@ std::string SUB_ID;
 std::string MQTT_PUB_TOPIC;
 std::string MQTT_QT_PUB_TOPIC;
 std::string MQTT_TOPIC_LED_ON;
+std::string MQTT_TOPIC_LED_OFF;
+std::string MQTT_TOPIC_TRACE_DIAG;
 std::string LED_DEVICE_PATH = "/dev/gpioled";
 
 std::atomic<bool> running(true);
@@ -241,7 +246,9 @@ void turn_off_led() {
 }
 
 void process_frame_and_publish(const std::string& topic, mqtt::async_client* client,
-    CrowdDetector* detector, int qos = 1) {
+    CrowdDetector* detector, const std::string& request_id = "", int qos = 1) {
+    TraceSpan span(TraceStage::PeopleCount);
+
     cv::Mat frame;
     {
         std::lock_guard<std::mutex> lock(frame_mutex);
@@ -252,11 +259,16 @@ void process_frame_and_publish(const std::string& topic, mqtt::async_client* cli
     }
 
     if (!frame.empty()) {
-        std::vector<cv::Point> people = detector->detect(frame);
+        // Counts are published, so they run at the full input size unless the size policy is enabled for periodic ones
+        const bool adaptive = PERIODIC_COUNT_ADAPTIVE_INPUT && topic == MQTT_PERIODIC_TOPIC;
+        std::vector<CrowdInfo> people = adaptive ? detector->detectAdaptive(frame) : detector->detect(frame);
         int people_count = static_cast<int>(people.size());
         std::string payload = std::to_string(people_count);
         std::string topic_send;
 
+        // Echo the incident id of the capture request, so the main server credits the right incident
+        if (!request_id.empty() && std::all_of(request_id.begin(), request_id.end(), [](unsigned char c) { return std::isdigit(c); })) payload += " " + request_id;
+
         if (topic == MQTT_EVENT_TOPIC) topic_send = MQTT_PUB_TOPIC;
         else if (topic == MQTT_PERIODIC_TOPIC) topic_send = MQTT_QT_PUB_TOPIC;
         else topic_send = topic; // fallback
@@ -276,6 +288,20 @@ void process_frame_and_publish(const std::string& topic, mqtt::async_client* cli
     }
 }
 
+// ====== Latency Report ======
+void publish_trace_report(mqtt::async_client* client) {
+    tracer().collect();
+
+    try {
+        auto msg = mqtt::make_message(MQTT_TOPIC_TRACE_DIAG, tracer().report("sub_" + SUB_ID));
+        msg->set_qos(0);
+        client->publish(msg);
+    }
+    catch (const mqtt::exception& e) {
+        std::cerr << "[MQTT ERROR] Publish failed on " << MQTT_TOPIC_TRACE_DIAG << ": " << e.what() << std::endl;
+    }
+}
+
 // ====== MQTT Thread & Callback ======
 void mqtt_thread_func() {
     mqtt::async_client client(MQTT_BROKER, "sub_pi_" + SUB_ID);
@@ -298,12 +324,13 @@ void mqtt_thread_func() {
             std::string topic = msg->get_topic();
             if (topic == MQTT_EVENT_TOPIC) {
                 capture_requested = true;
-                std::thread([this]() {
+                std::string request_id(msg->get_payload().begin(), msg->get_payload().end());  // Incident id
+                std::thread([this, request_id]() {
                     int attempts = 0;
                     while (attempts++ < 60 && capture_requested.load()) {
                         std::this_thread::sleep_for(std::chrono::milliseconds(50));
                     }
-                    process_frame_and_publish(MQTT_EVENT_TOPIC, client, detector);
+                    process_frame_and_publish(MQTT_EVENT_TOPIC, client, detector, request_id);
                     }).detach();
             }
             else if (topic == MQTT_PERIODIC_TOPIC) {
@@ -324,6 +351,11 @@ void mqtt_thread_func() {
                 turn_on_led();
                 std::cout << "[MQTT] led on: " << topic << std::endl;
             }
+            else if (topic == MQTT_TOPIC_LED_OFF) {
+                // Auto-off from the main server once LED_ON_DURATION_MS has passed
+                turn_off_led();
+                std::cout << "[MQTT] led off: " << topic << std::endl;
+            }
             else if (topic == MQTT_TOPIC_OFF_ORDER_FROM_QT) {
                 // if (led_on_flag) {
                 //     turn_off_led();
@@ -351,9 +383,18 @@ void mqtt_thread_func() {
         client.subscribe(MQTT_PERIODIC_TOPIC, 1);
         client.subscribe(MQTT_TOPIC_OFF_ORDER_FROM_QT, 1);
         client.subscribe(MQTT_TOPIC_LED_ON, 1);
+        client.subscribe(MQTT_TOPIC_LED_OFF, 1);
+
+        const std::chrono::milliseconds trace_dump_interval(TRACE_DUMP_INTERVAL_MS);
+        auto next_trace_dump = std::chrono::steady_clock::now() + trace_dump_interval;
 
         while (running) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+            if (std::chrono::steady_clock::now() >= next_trace_dump) {
+                publish_trace_report(&client);
+                next_trace_dump += trace_dump_interval;
+            }
         }
         client.disconnect()->wait();
     }
@@ -373,8 +414,14 @@ int main(int argc, char* argv[]) {
     MQTT_PUB_TOPIC = "sub/capture/" + SUB_ID;
     MQTT_QT_PUB_TOPIC = "pop/" + SUB_ID;
     MQTT_TOPIC_LED_ON = "sub/led/on/" + SUB_ID;
+    MQTT_TOPIC_LED_OFF = "sub/led/off/" + SUB_ID;
+    MQTT_TOPIC_TRACE_DIAG = "sub/diag/trace/" + SUB_ID;
     LED_DEVICE_PATH += SUB_ID;
 
+    // The detector was warmed up during static initialization; those runs are not latency samples
+    tracer().collect();
+    tracer().reset();
+
     gst_init(&argc, &argv);
     g_unix_signal_add(SIGINT, intr_handler, NULL);
     loop = g_main_loop_new(NULL, FALSE);
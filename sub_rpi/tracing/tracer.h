@@ -0,0 +1,185 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+// Standard Library
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Project headers
+#include "config.h"
+
+/**
+ * @brief Pipeline stage a latency sample belongs to.
+ */
+enum class TraceStage : uint8_t {
+    TriggerToImage,     ///< Fall trigger to CH1 capture in
+    Decode,             ///< JPEG decode of a capture
+    Preprocess,         ///< Letterbox and tensor fill
+    Inference,          ///< ONNX session run
+    TensorDecode,       ///< Output tensor to candidate boxes
+    Nms,                ///< Suppression (and the cross-tile merge)
+    PeopleCount,        ///< Whole people count job (periodic or sub-camera), frame to publish
+    Congestion,         ///< Congestion grid
+    PathSearch,         ///< A* to every exit
+    Render,             ///< Heatmap, exits and path drawing
+    Encode,             ///< Path image JPEG encode
+    Publish,            ///< LED command, log and image publish
+    TriggerToPublish    ///< Fall trigger to first publish of its incident
+};
+
+constexpr size_t TRACE_STAGE_COUNT = 13;
+
+/**
+ * @brief Returns the snake_case name of a stage, as used in reports.
+ */
+const char* traceStageName(TraceStage stage);
+
+/**
+ * @brief Log-linear latency histogram in microseconds (HDR histogram layout).
+ *
+ * Values below 32 us get a bucket each; every power of two above is split
+ * into 16 buckets, so a percentile is within 1/16 of the recorded value
+ * whatever its magnitude. Fixed size, no allocation; not thread-safe.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr int MAX_MAGNITUDE = 40;    ///< Values from 2^40 us (about 12 days) share the last bucket
+    static constexpr size_t BUCKET_COUNT = (1u << SUB_BUCKET_BITS) + (MAX_MAGNITUDE - SUB_BUCKET_BITS) * (1u << (SUB_BUCKET_BITS - 1));
+
+    /**
+     * @brief Adds one sample.
+     * @param Latency in microseconds
+     */
+    void record(uint64_t value_us);
+
+    /**
+     * @brief Adds every sample of another histogram.
+     */
+    void merge(const LatencyHistogram& other);
+
+    void reset();
+
+    uint64_t count() const { return total; }
+    uint64_t min() const { return total ? min_value : 0; }
+    uint64_t max() const { return max_value; }
+    double mean() const { return total ? static_cast<double>(sum) / static_cast<double>(total) : 0.0; }
+
+    /**
+     * @brief Returns the value at a percentile.
+     * @param Percentile in [0, 100]
+     * @return Upper bound of the bucket holding that sample, at most max() (0 if empty)
+     */
+    uint64_t percentile(double percent) const;
+
+private:
+    static size_t bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(size_t index);
+
+    std::array<uint64_t, BUCKET_COUNT> buckets = {};
+    uint64_t total = 0;
+    uint64_t sum = 0;
+    uint64_t min_value = UINT64_MAX;
+    uint64_t max_value = 0;
+};
+
+class TraceRing;
+
+/**
+ * @brief Process-wide collector of stage latencies.
+ *
+ * record() appends to a ring owned by the calling thread, with no lock and no
+ * allocation after the thread's first sample. collect() drains every ring
+ * into one histogram per stage; it is meant to run from a periodic timer, at
+ * least once per TRACE_RING_CAPACITY samples of the busiest thread, or the
+ * excess is counted as dropped.
+ */
+class Tracer {
+public:
+    Tracer() = default;
+    ~Tracer();
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    /**
+     * @brief Records one sample on the calling thread's ring (no-op without TRACE_ENABLED).
+     */
+    void record(TraceStage stage, std::chrono::steady_clock::duration elapsed);
+
+    /**
+     * @brief Moves the samples of every thread into the stage histograms.
+     */
+    void collect();
+
+    /**
+     * @brief Returns a copy of a stage histogram as of the last collect().
+     */
+    LatencyHistogram histogram(TraceStage stage) const;
+
+    /**
+     * @brief Returns the stage histograms as JSON: count, mean, p50, p90, p99 and max in milliseconds per stage.
+     * @param Source name put in the report (e.g. "main", "sub_1")
+     */
+    std::string report(const std::string& source) const;
+
+    /**
+     * @brief Writes report() to a file, replacing it.
+     * @return false if the file could not be written
+     */
+    bool dumpToFile(const std::string& path, const std::string& source) const;
+
+    /**
+     * @brief Clears the histograms; samples still in the rings are kept.
+     */
+    void reset();
+
+private:
+    TraceRing& localRing();
+
+    mutable std::mutex mutex;                           ///< Guards rings, histograms and dropped
+    std::vector<std::shared_ptr<TraceRing>> rings;      ///< One per thread that recorded; kept until drained after the thread exits
+    std::array<LatencyHistogram, TRACE_STAGE_COUNT> histograms;
+    uint64_t dropped = 0;                               ///< Samples lost to full rings
+};
+
+/**
+ * @brief Returns the process-wide tracer.
+ */
+Tracer& tracer();
+
+/**
+ * @brief RAII span: records the time from construction to stop() or destruction.
+ */
+class TraceSpan {
+public:
+    explicit TraceSpan(TraceStage stage)
+        : stage(stage), start(std::chrono::steady_clock::now()), active(TRACE_ENABLED) {}
+
+    ~TraceSpan() { stop(); }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    /**
+     * @brief Ends the span early; later calls do nothing.
+     */
+    void stop() {
+        if (!active) return;
+        active = false;
+        tracer().record(stage, std::chrono::steady_clock::now() - start);
+    }
+
+private:
+    TraceStage stage;
+    std::chrono::steady_clock::time_point start;
+    bool active;
+};
+
+#endif  // TRACER_H
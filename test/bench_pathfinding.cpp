@@ -0,0 +1,299 @@
+// Standard Library
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <memory>
+#include <queue>
+#include <cmath>
+#include <algorithm>
+
+// Project Headers
+#include "congestion_analyzer.h"
+#include "path_finder.h"
+#include "config.h"
+
+// 4K CH1 frame with the configured 20 px cells: 192 x 108 grid
+constexpr int BENCH_IMAGE_WIDTH = 3840;
+constexpr int BENCH_IMAGE_HEIGHT = 2160;
+constexpr int BENCH_SPARSE_PEOPLE = 20;
+constexpr int BENCH_CROWDED_PEOPLE = 600;
+constexpr int BENCH_SEARCHES = 16;
+constexpr int BENCH_EXIT_COUNTS[] = { 2, 3, 4, 6, 8, 10, 12, 16, 24 };
+constexpr float BENCH_COST_TOLERANCE = 1e-3f;
+
+// Configuration constants
+const int repeat_count = 20;
+
+// Helper functions
+std::vector<cv::Point> makeCrowd(int people, std::mt19937& gen);
+std::vector<cv::Point> makeExits(int count, int cols, int rows);
+std::vector<cv::Point> referenceAStar(const Grid<float>& congestion, const cv::Point& start_pixel, const cv::Point& goal_pixel);
+float searchCost(const Grid<float>& congestion, const std::vector<cv::Point>& path);
+bool runScenario(const char* name, int people, std::mt19937& gen);
+bool runExitSweep(Pathfinder& pathfinder, const Grid<float>& congestion, const std::vector<cv::Point>& starts);
+
+int main()
+{
+	std::mt19937 gen(42);
+
+	bool passed = true;
+	passed &= runScenario("sparse", BENCH_SPARSE_PEOPLE, gen);
+	passed &= runScenario("crowded", BENCH_CROWDED_PEOPLE, gen);
+
+	if (!passed)
+	{
+		std::cerr << std::endl;
+		std::cerr << "[Error] Indexed search differs from the reference search!" << std::endl;
+
+		return -1;
+	}
+
+	return 0;
+}
+
+// Time the reference and indexed A* between random starts and the fallback exits, and compare path costs
+bool runScenario(const char* name, int people, std::mt19937& gen)
+{
+	CongestionAnalyzer analyzer(BENCH_IMAGE_WIDTH, BENCH_IMAGE_HEIGHT);
+	const Grid<float> congestion = analyzer.analyzeCongestionGrid(makeCrowd(people, gen));
+
+	const int cols = congestion.cols();
+	const int rows = congestion.rows();
+	const std::vector<cv::Point> goals = {
+		toPixelCenter(cv::Point(0, 0)),
+		toPixelCenter(cv::Point(cols - 1, 0)),
+		toPixelCenter(cv::Point(0, rows - 1))
+	};
+
+	std::uniform_int_distribution<> rand_x(0, cols - 1);
+	std::uniform_int_distribution<> rand_y(0, rows - 1);
+	std::vector<cv::Point> starts;
+	for (int i = 0; i < BENCH_SEARCHES; ++i) starts.push_back(toPixelCenter(cv::Point(rand_x(gen), rand_y(gen))));
+
+	Pathfinder pathfinder(BENCH_IMAGE_WIDTH, BENCH_IMAGE_HEIGHT);
+	pathfinder.setCongestionMap(congestion);
+	pathfinder.calculatePath(starts.front(), goals.front());  // Sizes the search arrays; not timed
+
+	float reference_ms = 0.0f;
+	float indexed_ms = 0.0f;
+	std::vector<float> pair_indexed_ms(starts.size() * goals.size(), 0.0f);
+	bool same_cost = true;
+
+	for (int r = 0; r < repeat_count; ++r)
+	{
+		for (size_t s = 0; s < starts.size(); ++s)
+		{
+			for (size_t e = 0; e < goals.size(); ++e)
+			{
+				const cv::Point& start = starts[s];
+				const cv::Point& goal = goals[e];
+
+				auto t0 = std::chrono::high_resolution_clock::now();
+				const std::vector<cv::Point> reference = referenceAStar(congestion, start, goal);
+				auto t1 = std::chrono::high_resolution_clock::now();
+				const std::vector<cv::Point> path = pathfinder.calculatePath(start, goal);
+				auto t2 = std::chrono::high_resolution_clock::now();
+
+				const float search_ms = std::chrono::duration<float, std::milli>(t2 - t1).count();
+				reference_ms += std::chrono::duration<float, std::milli>(t1 - t0).count();
+				indexed_ms += search_ms;
+				pair_indexed_ms[s * goals.size() + e] += search_ms;
+
+				// Ties may pick different cells; the optimal cost is unique
+				const float reference_cost = searchCost(congestion, reference);
+				const float cost = searchCost(congestion, path);
+				if (path.empty() != reference.empty() || std::abs(cost - reference_cost) > BENCH_COST_TOLERANCE * std::max(1.0f, reference_cost)) same_cost = false;
+			}
+		}
+	}
+
+	const float searches = static_cast<float>(repeat_count * starts.size() * goals.size());
+	const float worst_pair_ms = *std::max_element(pair_indexed_ms.begin(), pair_indexed_ms.end()) / repeat_count;
+
+	std::cout << "[" << name << "] " << people << " people, " << cols << "x" << rows << " grid" << std::endl;
+	std::cout << "  reference A* " << reference_ms / searches << " ms per search" << std::endl;
+	std::cout << "  indexed A*   " << indexed_ms / searches << " ms per search (slowest start/exit pair " << worst_pair_ms << " ms)" << std::endl;
+
+	same_cost &= runExitSweep(pathfinder, congestion, starts);
+
+	return same_cost;
+}
+
+// Time one A* per exit against one Dijkstra sweep for all of them, for growing exit counts, and report where the sweep starts winning
+bool runExitSweep(Pathfinder& pathfinder, const Grid<float>& congestion, const std::vector<cv::Point>& starts)
+{
+	bool same_cost = true;
+	int crossover = 0;
+
+	for (int exit_count : BENCH_EXIT_COUNTS)
+	{
+		const std::vector<cv::Point> goals = makeExits(exit_count, congestion.cols(), congestion.rows());
+
+		float per_exit_ms = 0.0f;
+		float sweep_ms = 0.0f;
+		float routing_ms = 0.0f;
+
+		for (int r = 0; r < repeat_count; ++r)
+		{
+			for (const auto& start : starts)
+			{
+				std::vector<std::vector<cv::Point>> single_paths;
+
+				auto t0 = std::chrono::high_resolution_clock::now();
+				for (const auto& goal : goals) single_paths.push_back(pathfinder.calculatePath(start, goal));
+				auto t1 = std::chrono::high_resolution_clock::now();
+				const std::vector<std::vector<cv::Point>> paths = pathfinder.calculatePathsBySweep(start, goals);
+				auto t2 = std::chrono::high_resolution_clock::now();
+				pathfinder.calculatePaths(start, goals);
+				auto t3 = std::chrono::high_resolution_clock::now();
+
+				per_exit_ms += std::chrono::duration<float, std::milli>(t1 - t0).count();
+				sweep_ms += std::chrono::duration<float, std::milli>(t2 - t1).count();
+				routing_ms += std::chrono::duration<float, std::milli>(t3 - t2).count();
+
+				for (size_t e = 0; e < goals.size(); ++e)
+				{
+					const float single_cost = searchCost(congestion, single_paths[e]);
+					const float cost = searchCost(congestion, paths[e]);
+					if (paths[e].empty() != single_paths[e].empty() || std::abs(cost - single_cost) > BENCH_COST_TOLERANCE * std::max(1.0f, single_cost)) same_cost = false;
+				}
+			}
+		}
+
+		if (crossover == 0 && sweep_ms < per_exit_ms) crossover = exit_count;
+
+		const float routings = static_cast<float>(repeat_count * starts.size());
+		std::cout << "  " << exit_count << " exits: A* per exit " << per_exit_ms / routings << " ms, sweep " << sweep_ms / routings
+			<< " ms, calculatePaths " << routing_ms / routings << " ms per routing" << std::endl;
+	}
+
+	std::cout << "  sweep wins from ";
+	if (crossover > 0) std::cout << crossover << " exits";
+	else std::cout << "no measured exit count";
+	std::cout << " (PATH_SWEEP_MIN_GOALS = " << PATH_SWEEP_MIN_GOALS << ")" << std::endl;
+
+	return same_cost;
+}
+
+// People spread uniformly, plus a dense cluster in the middle of the frame
+std::vector<cv::Point> makeCrowd(int people, std::mt19937& gen)
+{
+	std::uniform_int_distribution<> rand_x(0, BENCH_IMAGE_WIDTH - 1);
+	std::uniform_int_distribution<> rand_y(0, BENCH_IMAGE_HEIGHT - 1);
+	std::normal_distribution<float> cluster_x(BENCH_IMAGE_WIDTH / 2.0f, BENCH_IMAGE_WIDTH / 10.0f);
+	std::normal_distribution<float> cluster_y(BENCH_IMAGE_HEIGHT / 2.0f, BENCH_IMAGE_HEIGHT / 10.0f);
+
+	std::vector<cv::Point> crowd;
+	for (int i = 0; i < people; ++i)
+	{
+		if (i % 2 == 0) crowd.push_back(cv::Point(rand_x(gen), rand_y(gen)));
+		else crowd.push_back(cv::Point(std::clamp(static_cast<int>(cluster_x(gen)), 0, BENCH_IMAGE_WIDTH - 1),
+			std::clamp(static_cast<int>(cluster_y(gen)), 0, BENCH_IMAGE_HEIGHT - 1)));
+	}
+
+	return crowd;
+}
+
+// Exits spread along the map border, starting at the fallback corners
+std::vector<cv::Point> makeExits(int count, int cols, int rows)
+{
+	const std::vector<cv::Point> corners = { cv::Point(0, 0), cv::Point(cols - 1, 0), cv::Point(0, rows - 1), cv::Point(cols - 1, rows - 1) };
+	const int perimeter = 2 * (cols + rows) - 4;
+
+	std::vector<cv::Point> exits;
+	for (int i = 0; i < count; ++i)
+	{
+		if (i < static_cast<int>(corners.size()))
+		{
+			exits.push_back(toPixelCenter(corners[i]));
+			continue;
+		}
+
+		// Walk the border clockwise from the top-left corner
+		int t = (i * perimeter) / count + perimeter / (2 * count);
+		cv::Point cell;
+		if (t < cols) cell = cv::Point(t, 0);
+		else if ((t -= cols) < rows - 1) cell = cv::Point(cols - 1, t + 1);
+		else if ((t -= rows - 1) < cols - 1) cell = cv::Point(cols - 2 - t, rows - 1);
+		else cell = cv::Point(0, rows - 2 - (t - (cols - 1)));
+		exits.push_back(toPixelCenter(cell));
+	}
+
+	return exits;
+}
+
+// A* as it was before the indexed rewrite: shared_ptr nodes, duplicate pushes, Euclidean heuristic
+std::vector<cv::Point> referenceAStar(const Grid<float>& congestion, const cv::Point& start_pixel, const cv::Point& goal_pixel)
+{
+	const int rows = congestion.rows();
+	const int cols = congestion.cols();
+
+	struct Node {
+		int x, y;
+		float g, h;
+		std::shared_ptr<Node> parent;
+		float f() const { return g + h; }
+	};
+
+	auto cmp = [](const std::shared_ptr<Node>& a, const std::shared_ptr<Node>& b) { return a->f() > b->f(); };
+	std::priority_queue<std::shared_ptr<Node>, std::vector<std::shared_ptr<Node>>, decltype(cmp)> open(cmp);
+	std::vector<std::vector<bool>> visited(rows, std::vector<bool>(cols, false));
+
+	cv::Point grid_start = toGrid(start_pixel);
+	cv::Point grid_goal = toGrid(goal_pixel);
+
+	float initial_h = static_cast<float>(cv::norm(grid_start - grid_goal));
+	open.push(std::make_shared<Node>(Node{ grid_start.x, grid_start.y, 0.0f, initial_h, nullptr }));
+
+	const std::vector<cv::Point> directions = { {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {-1, 1}, {-1, -1}, {1, -1} };
+
+	while (!open.empty())
+	{
+		auto current = open.top();
+		open.pop();
+
+		if (current->x == grid_goal.x && current->y == grid_goal.y)
+		{
+			std::vector<cv::Point> path;
+			for (auto n = current; n; n = n->parent) path.push_back(toPixelCenter(cv::Point(n->x, n->y)));
+			std::reverse(path.begin(), path.end());
+			return path;
+		}
+
+		if (current->x < 0 || current->y < 0 || current->x >= cols || current->y >= rows) continue;
+		if (visited[current->y][current->x]) continue;
+		visited[current->y][current->x] = true;
+
+		for (const auto& d : directions)
+		{
+			int nx = current->x + d.x;
+			int ny = current->y + d.y;
+
+			if (nx < 0 || ny < 0 || nx >= cols || ny >= rows) continue;
+			if (visited[ny][nx]) continue;
+
+			float cost = std::hypot(static_cast<float>(d.x), static_cast<float>(d.y)) * (1.0f + congestion.at(ny, nx));
+			float g = current->g + cost;
+			float h = static_cast<float>(cv::norm(cv::Point(nx, ny) - grid_goal));
+
+			open.push(std::make_shared<Node>(Node{ nx, ny, g, h, current }));
+		}
+	}
+
+	return {};
+}
+
+// Cost the search minimizes, in grid units
+float searchCost(const Grid<float>& congestion, const std::vector<cv::Point>& path)
+{
+	float cost = 0.0f;
+
+	for (size_t i = 1; i < path.size(); ++i)
+	{
+		const cv::Point cell = toGrid(path[i]);
+		const cv::Point step = cell - toGrid(path[i - 1]);
+		cost += std::hypot(static_cast<float>(step.x), static_cast<float>(step.y)) * (1.0f + congestion.at(cell));
+	}
+
+	return cost;
+}
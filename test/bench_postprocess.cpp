@@ -0,0 +1,188 @@
+// Standard Library
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+// Project Headers
+#include "yolo_layout.h"
+#include "yolo_nms.h"
+#include "config.h"
+
+// Synthetic YOLOv8 output shape (640 input: 80x80 + 40x40 + 20x20 anchors)
+constexpr int BENCH_NUM_BOXES = 8400;
+constexpr int BENCH_NUM_CLASSES = 1;
+constexpr int BENCH_SPARSE_PEOPLE = 4;
+constexpr int BENCH_CROWDED_PEOPLE = 120;
+constexpr int BENCH_CANDIDATES_PER_PERSON = 12;
+
+// Configuration constants
+const int repeat_count = 200;
+
+// Helper functions
+std::vector<float> makeOutput(int people, std::mt19937& gen);
+void referenceDecode(const float* data, size_t num_boxes, size_t num_classes, float conf_threshold, YoloCandidates& out);
+std::vector<int> referenceNms(const std::vector<cv::Rect>& boxes, const std::vector<float>& scores, float iou_threshold);
+bool runScenario(const char* name, int people, std::mt19937& gen);
+
+int main()
+{
+	std::mt19937 gen(42);
+
+	bool passed = true;
+	passed &= runScenario("sparse", BENCH_SPARSE_PEOPLE, gen);
+	passed &= runScenario("crowded", BENCH_CROWDED_PEOPLE, gen);
+
+	if (!passed)
+	{
+		std::cerr << std::endl;
+		std::cerr << "[Error] Vectorized postprocessing differs from the scalar reference!" << std::endl;
+
+		return -1;
+	}
+
+	return 0;
+}
+
+// Time scalar and vectorized decode + NMS on one synthetic output and compare results
+bool runScenario(const char* name, int people, std::mt19937& gen)
+{
+	const std::vector<float> output = makeOutput(people, gen);
+	const std::vector<int64_t> shape = { 1, 4 + BENCH_NUM_CLASSES, BENCH_NUM_BOXES };
+
+	YoloCandidates reference;
+	YoloCandidates candidates;
+	std::vector<int> reference_keep;
+	std::vector<int> keep;
+	YoloNms nms;
+
+	float reference_decode_ms = 0.0f, reference_nms_ms = 0.0f;
+	float decode_ms = 0.0f, nms_ms = 0.0f;
+
+	for (int i = 0; i < repeat_count; ++i)
+	{
+		auto t0 = std::chrono::high_resolution_clock::now();
+		reference.clear();
+		referenceDecode(output.data(), BENCH_NUM_BOXES, BENCH_NUM_CLASSES, FALL_CONF_THRESHOLD, reference);
+		auto t1 = std::chrono::high_resolution_clock::now();
+		reference_keep = referenceNms(reference.boxes, reference.scores, NMS_THRESHOLD);
+		auto t2 = std::chrono::high_resolution_clock::now();
+
+		candidates.clear();
+		YoloV8Layout::decode(output.data(), shape, FALL_CONF_THRESHOLD, -1, 1.0f, 0, 0, candidates);
+		auto t3 = std::chrono::high_resolution_clock::now();
+		keep = nms.run(candidates.boxes, candidates.scores, NMS_THRESHOLD);
+		auto t4 = std::chrono::high_resolution_clock::now();
+
+		reference_decode_ms += std::chrono::duration<float, std::milli>(t1 - t0).count();
+		reference_nms_ms += std::chrono::duration<float, std::milli>(t2 - t1).count();
+		decode_ms += std::chrono::duration<float, std::milli>(t3 - t2).count();
+		nms_ms += std::chrono::duration<float, std::milli>(t4 - t3).count();
+	}
+
+	std::cout << "[" << name << "] " << reference.boxes.size() << " candidates, " << keep.size() << " kept" << std::endl;
+	std::cout << "  scalar decode " << reference_decode_ms / repeat_count << " ms, NMS " << reference_nms_ms / repeat_count << " ms" << std::endl;
+	std::cout << "  vector decode " << decode_ms / repeat_count << " ms, NMS " << nms_ms / repeat_count << " ms" << std::endl;
+
+	return reference.boxes == candidates.boxes && reference.scores == candidates.scores && reference_keep == keep;
+}
+
+// Background anchors below threshold plus a cluster of overlapping candidates per person
+std::vector<float> makeOutput(int people, std::mt19937& gen)
+{
+	const size_t n = BENCH_NUM_BOXES;
+	std::vector<float> output((4 + BENCH_NUM_CLASSES) * n);
+
+	std::uniform_real_distribution<float> pos(40.0f, 600.0f);
+	std::uniform_real_distribution<float> size(20.0f, 80.0f);
+	std::uniform_real_distribution<float> jitter(-4.0f, 4.0f);
+	std::uniform_real_distribution<float> low(0.0f, 0.2f);
+	std::uniform_real_distribution<float> high(0.35f, 0.95f);
+	std::uniform_int_distribution<size_t> slot(0, n - 1);
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		output[i] = pos(gen);
+		output[i + n] = pos(gen);
+		output[i + 2 * n] = size(gen);
+		output[i + 3 * n] = size(gen);
+		for (int c = 0; c < BENCH_NUM_CLASSES; ++c) output[i + (4 + c) * n] = low(gen);
+	}
+
+	for (int p = 0; p < people; ++p)
+	{
+		const float cx = pos(gen), cy = pos(gen), w = size(gen), h = size(gen);
+
+		for (int k = 0; k < BENCH_CANDIDATES_PER_PERSON; ++k)
+		{
+			const size_t i = slot(gen);
+			output[i] = cx + jitter(gen);
+			output[i + n] = cy + jitter(gen);
+			output[i + 2 * n] = w + jitter(gen);
+			output[i + 3 * n] = h + jitter(gen);
+			output[i + 4 * n] = high(gen);
+		}
+	}
+
+	return output;
+}
+
+// Scalar decode as it was before vectorization (identity letterbox)
+void referenceDecode(const float* data, size_t num_boxes, size_t num_classes, float conf_threshold, YoloCandidates& out)
+{
+	for (size_t i = 0; i < num_boxes; ++i)
+	{
+		float max_conf = 0.0f;
+		int cls = -1;
+
+		for (size_t c = 0; c < num_classes; ++c)
+		{
+			const float score = data[i + (4 + c) * num_boxes];
+			if (score > max_conf)
+			{
+				max_conf = score;
+				cls = static_cast<int>(c);
+			}
+		}
+
+		if (max_conf <= conf_threshold) continue;
+
+		out.boxes.push_back(unletterboxRect(convertXywhToXyxy(data[i], data[i + num_boxes], data[i + 2 * num_boxes], data[i + 3 * num_boxes]), 1.0f, 0, 0));
+		out.scores.push_back(max_conf);
+		out.class_ids.push_back(cls);
+	}
+}
+
+// Scalar greedy NMS as it was before vectorization
+std::vector<int> referenceNms(const std::vector<cv::Rect>& boxes, const std::vector<float>& scores, float iou_threshold)
+{
+	std::vector<int> keep;
+	std::vector<std::pair<float, int>> order;
+
+	for (size_t i = 0; i < scores.size(); ++i) order.emplace_back(scores[i], static_cast<int>(i));
+
+	std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) {
+		return a.first > b.first || (a.first == b.first && a.second < b.second);
+		});
+
+	std::vector<bool> suppressed(scores.size(), false);
+
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		int idx = order[i].second;
+		if (suppressed[idx]) continue;
+
+		keep.push_back(idx);
+
+		for (size_t j = i + 1; j < order.size(); ++j)
+		{
+			int next_idx = order[j].second;
+			float inter = static_cast<float>((boxes[idx] & boxes[next_idx]).area());
+			float uni = static_cast<float>(boxes[idx].area() + boxes[next_idx].area() - inter);
+
+			if (inter / (uni + 1e-6f) > iou_threshold) suppressed[next_idx] = true;
+		}
+	}
+
+	return keep;
+}
@@ -0,0 +1,127 @@
+// Standard Library
+#include <iostream>
+#include <chrono>
+#include <cmath>
+
+// Project Headers
+#include "fall_detector.h"
+#include "crowd_detector.h"
+#include "config.h"
+
+// Center distance within which a detection counts as the same person
+constexpr float RECALL_COORD_TOLERANCE = 16.0f;
+
+// Configuration constants
+const int repeat_count = 5;
+
+// Tile sizes and overlaps to sweep (the last combination serves as reference)
+const std::vector<int> tile_sizes = { 640, 512, 416 };
+const std::vector<float> tile_overlaps = { 0.1f, 0.25f };
+
+// Helper functions
+float recall(const std::vector<cv::Point>& reference, const std::vector<cv::Point>& candidate);
+template <typename Detector, typename Centers>
+void sweep(const char* name, Detector& detector, const cv::Mat& image, Centers centers);
+
+int main()
+{
+	cv::Mat fall_image = cv::imread("fall00.png");
+	cv::Mat crowd_image = cv::imread("crowd00.jpg");
+	if (fall_image.empty() || crowd_image.empty())
+	{
+		std::cerr << "Unable to read fall00.png / crowd00.jpg" << std::endl;
+
+		return -1;
+	}
+
+	FallDetector fall_detector(FALL_MODEL_PATH);
+	CrowdDetector crowd_detector(CROWD_MODEL_PATH);
+
+	// All person boxes count for the fall model, not only falls
+	sweep("fall", fall_detector, fall_image, [](const std::vector<FallInfo>& info) {
+		std::vector<cv::Point> centers;
+		for (const auto& i : info) centers.push_back(i.bbox.tl() + cv::Point(i.bbox.width / 2, i.bbox.height / 2));
+		return centers;
+		});
+	sweep("crowd", crowd_detector, crowd_image, [&crowd_detector](const std::vector<CrowdInfo>& info) {
+		return crowd_detector.getCrowdCenters(info);
+		});
+
+	return 0;
+}
+
+// Latency and recall of every tiling setting, against the densest setting
+template <typename Detector, typename Centers>
+void sweep(const char* name, Detector& detector, const cv::Mat& image, Centers centers)
+{
+	struct Result { std::string label; float ms; std::vector<cv::Point> points; };
+	std::vector<Result> results;
+
+	auto measure = [&](const std::string& label, const YoloTileOptions& tiling) {
+		detector.setTiling(tiling);
+		detector.detect(image);  // First run at a new setting includes batch shape setup
+
+		std::vector<cv::Point> points;
+		auto t0 = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < repeat_count; ++i) points = centers(detector.detect(image));
+		auto t1 = std::chrono::high_resolution_clock::now();
+
+		results.push_back({ label, std::chrono::duration<float, std::milli>(t1 - t0).count() / repeat_count, points });
+	};
+
+	YoloTileOptions tiling;
+	tiling.enabled = false;
+	measure("off", tiling);
+
+	tiling.enabled = true;
+	for (int size : tile_sizes)
+	{
+		for (float overlap : tile_overlaps)
+		{
+			tiling.tile_size = size;
+			tiling.overlap = overlap;
+			measure(std::to_string(size) + " / " + std::to_string(static_cast<int>(overlap * 100)) + "%", tiling);
+		}
+	}
+
+	detector.setTiling(YoloTileOptions{});
+
+	const std::vector<cv::Point>& reference = results.back().points;
+
+	std::cout << "[" << name << "] " << image.cols << "x" << image.rows << ", "
+		<< YoloEngineBase::tileGrid(image.size(), tile_sizes.back(), tile_overlaps.back()).size() << " tiles at reference" << std::endl;
+
+	for (const auto& r : results)
+	{
+		std::cout << "  tile " << r.label << ": " << r.ms << " ms, " << r.points.size() << " people, recall " << recall(reference, r.points) << std::endl;
+	}
+	std::cout << std::endl;
+}
+
+// Fraction of reference points matched one-to-one by the candidate set
+float recall(const std::vector<cv::Point>& reference, const std::vector<cv::Point>& candidate)
+{
+	if (reference.empty()) return 1.0f;
+
+	std::vector<bool> matched(candidate.size(), false);
+	size_t match_count = 0;
+
+	for (const auto& p : reference)
+	{
+		for (size_t i = 0; i < candidate.size(); ++i)
+		{
+			const float dx = static_cast<float>(p.x - candidate[i].x);
+			const float dy = static_cast<float>(p.y - candidate[i].y);
+
+			if (!matched[i] && std::sqrt(dx * dx + dy * dy) <= RECALL_COORD_TOLERANCE)
+			{
+				matched[i] = true;
+				++match_count;
+
+				break;
+			}
+		}
+	}
+
+	return static_cast<float>(match_count) / reference.size();
+}
@@ -2,15 +2,12 @@
 #define CROWD_DETECTOR_H
 
 // Standard Library
-#include <memory>
 #include <vector>
 #include <string>
 
-// ONNX Runtime
-#include <onnxruntime_cxx_api.h>
-
 // Project headers
 #include "crowd_info.h"
+#include "yolo_engine.h"
 
 /**
  * @brief Performs crowd detection using a YOLO-based ONNX model.
@@ -19,19 +16,34 @@ class CrowdDetector {
 public:
     /**
      * @brief Constructor with model path
-     * @param Path to YOLO ONNX model
+     * @param Path to YOLO ONNX model (FP32)
+     * @param Requested precision; falls back to FP32 if the variant is unavailable
      */
-    explicit CrowdDetector(const std::string& model_path);
+    explicit CrowdDetector(const std::string& model_path, ModelPrecision precision = CROWD_MODEL_PRECISION);
 
     ~CrowdDetector() = default;
 
     /**
-     * @brief Perform crowd detection on an input image
+     * @brief Perform crowd detection on an input image (tiled when enabled)
      * @param Input BGR image
      * @return List of crowd information
      */
     std::vector<CrowdInfo> detect(const cv::Mat& image);
 
+    /**
+     * @brief Perform crowd detection at the input size chosen by the size policy
+     * @param Input BGR image
+     * @return List of crowd information
+     */
+    std::vector<CrowdInfo> detectAdaptive(const cv::Mat& image);
+
+    /**
+     * @brief Perform crowd detection on several images with batched inference
+     * @param Input BGR images
+     * @return List of crowd information per image, in input order
+     */
+    std::vector<std::vector<CrowdInfo>> detectBatch(const std::vector<cv::Mat>& images);
+
     /**
      * @brief Get center points of bboxes
      * @param Vector of crowd information
@@ -39,27 +51,26 @@ public:
      */
     std::vector<cv::Point> getCrowdCenters(const std::vector<CrowdInfo>& crowd_info);
 
+    /**
+     * @brief Enable, disable or re-parameterize tiled inference for detect()
+     * @param Tile settings
+     */
+    void setTiling(const YoloTileOptions& tiling);
+
     /**
      * @brief Run warm-up inference to initialize ONNX engine
      */
     void runWarmUp();
 
-private:
-    // === Inference core ===
-    static Ort::Env& getEnv();
-    static std::shared_ptr<Ort::Session> getSharedSession(const std::string& model_path);
-    Ort::Value runYoloInference(const std::vector<float>& input_tensor);
-
-    // === Pre/Post-processing ===
-    std::vector<float> preprocessYoloInput(const cv::Mat& image, float& scale, int& top, int& left);
-    void postprocessYoloOutput(Ort::Value& output_tensor, float scale, int top, int left, std::vector<CrowdInfo>& results);
-
-    // === Utilities ===
-    std::vector<int> applyNms(const std::vector<cv::Rect>& boxes, const std::vector<float>& scores);
-    float computeIoU(const cv::Rect& a, const cv::Rect& b);
+    /**
+     * @brief Get the precision of the loaded model
+     * @return Active model precision
+     */
+    ModelPrecision precision() const;
 
+private:
     // === Members ===
-    std::shared_ptr<Ort::Session> session;
+    YoloEngine<YoloV5Layout> engine;  ///< Rows of (x, y, w, h, conf, class)
 };
 
 #endif  // CROWD_DETECTOR_H
\ No newline at end of file
@@ -2,15 +2,12 @@
 #define FALL_DETECTOR_H
 
 // Standard Library
-#include <memory>
 #include <vector>
 #include <string>
 
-// ONNX Runtime
-#include <onnxruntime_cxx_api.h>
-
 // Project headers
 #include "fall_info.h"
+#include "yolo_engine.h"
 
 /**
  * @brief Fall detection class using YOLO model via ONNX Runtime
@@ -19,19 +16,34 @@ class FallDetector {
 public:
 	/**
 	 * @brief Constructor with model path
-	 * @param Path to YOLO ONNX model
+	 * @param Path to YOLO ONNX model (FP32)
+	 * @param Requested precision; falls back to FP32 if the variant is unavailable
 	 */
-	explicit FallDetector(const std::string& model_path);
+	explicit FallDetector(const std::string& model_path, ModelPrecision precision = FALL_MODEL_PRECISION);
 
 	~FallDetector() = default;
 
 	/**
-	 * @brief Perform fall detection on an input image
+	 * @brief Perform fall detection on an input image (tiled when enabled)
 	 * @param Input BGR image
 	 * @return List of fall information
 	 */
 	std::vector<FallInfo> detect(const cv::Mat& image);
 
+	/**
+	 * @brief Perform fall detection at the input size chosen by the size policy
+	 * @param Input BGR image
+	 * @return List of fall information
+	 */
+	std::vector<FallInfo> detectAdaptive(const cv::Mat& image);
+
+	/**
+	 * @brief Perform fall detection on several images with batched inference
+	 * @param Input BGR images
+	 * @return List of fall information per image, in input order
+	 */
+	std::vector<std::vector<FallInfo>> detectBatch(const std::vector<cv::Mat>& images);
+
 	/**
 	 * @brief Get center points of bboxes
 	 * @param Vector of fall information
@@ -39,26 +51,26 @@ public:
 	 */
 	std::vector<cv::Point> getFallCenters(const std::vector<FallInfo>& fall_info);
 
+	/**
+	 * @brief Enable, disable or re-parameterize tiled inference for detect()
+	 * @param Tile settings
+	 */
+	void setTiling(const YoloTileOptions& tiling);
+
 	/**
 	 * @brief Run warm-up inference to initialize ONNX engine
 	 */
 	void runWarmUp();
 
-private:
-	// === Inference core ===
-	static Ort::Env& getEnv();
-	static std::shared_ptr<Ort::Session> getSharedSession(const std::string& model_path);
-	Ort::Value runYoloInference(const std::vector<float>& input_tensor);
-
-	// === Pre/Post-processing ===
-	std::vector<float> preprocessYoloInput(const cv::Mat& image, float& scale, int& top, int& left);
-	void postprocessYoloOutput(Ort::Value& output_tensor, float scale, int top, int left, std::vector<FallInfo>& results);
-
-	// === Utilities ===
-	std::vector<int> applyNms(const std::vector<cv::Rect>& boxes, const std::vector<float>& scores);
+	/**
+	 * @brief Get the precision of the loaded model
+	 * @return Active model precision
+	 */
+	ModelPrecision precision() const;
 
+private:
 	// === Members ===
-	std::shared_ptr<Ort::Session> session;
+	YoloEngine<YoloV8Layout> engine;  ///< Channels-major YOLOv8 output
 };
 
 #endif  // FALL_DETECTOR_H
\ No newline at end of file
@@ -0,0 +1,118 @@
+#ifndef JPEG_CODEC_H
+#define JPEG_CODEC_H
+
+// Standard Library
+#include <string>
+#include <vector>
+#include <memory>
+
+// OpenCV
+#include <opencv2/opencv.hpp>
+
+// Project headers
+#include "config.h"
+
+/**
+ * @brief JPEG encoder settings.
+ */
+struct JpegEncodeOptions
+{
+    int quality = JPEG_QUALITY;             ///< 1 (smallest) to 100 (best)
+    bool progressive = JPEG_PROGRESSIVE;    ///< Progressive instead of baseline output
+};
+
+/**
+ * @brief Interface of a JPEG encode / decode backend.
+ */
+class JpegCodec
+{
+public:
+    virtual ~JpegCodec() = default;
+
+    /**
+     * @brief Returns the backend name for logs.
+     */
+    virtual const char* name() const = 0;
+
+    /**
+     * @brief Decodes a JPEG into a BGR image, scaled down in the DCT domain
+     * @param Encoded bytes
+     * @param Number of bytes
+     * @param Scale denominator: 1, 2, 4 or 8
+     * @return Decoded image, or an empty Mat on failure
+     */
+    virtual cv::Mat decode(const unsigned char* data, size_t size, int scale_denom = 1) const = 0;
+
+    /**
+     * @brief Encodes a BGR image as JPEG
+     * @param Image
+     * @param Output bytes (replaced)
+     * @param Encoder settings
+     * @return true if successful
+     */
+    virtual bool encode(const cv::Mat& image, std::vector<unsigned char>& out, const JpegEncodeOptions& options = {}) const = 0;
+
+    /**
+     * @brief Decodes a JPEG held in a byte vector
+     */
+    cv::Mat decode(const std::vector<unsigned char>& data, int scale_denom = 1) const {
+        return decode(data.data(), data.size(), scale_denom);
+    }
+
+    /**
+     * @brief Reads and decodes a JPEG file
+     * @param File path
+     * @param Scale denominator: 1, 2, 4 or 8
+     * @return Decoded image, or an empty Mat on failure
+     */
+    cv::Mat decodeFile(const std::string& path, int scale_denom = 1) const;
+};
+
+/**
+ * @brief Backend built on cv::imdecode / cv::imencode (IMREAD_REDUCED_* for scaled decode).
+ */
+class OpenCvJpegCodec : public JpegCodec
+{
+public:
+    const char* name() const override { return "opencv"; }
+    cv::Mat decode(const unsigned char* data, size_t size, int scale_denom = 1) const override;
+    bool encode(const cv::Mat& image, std::vector<unsigned char>& out, const JpegEncodeOptions& options = {}) const override;
+    using JpegCodec::decode;
+};
+
+#if defined(HAVE_TURBOJPEG)
+/**
+ * @brief Backend built on the libjpeg-turbo TurboJPEG API (one handle per thread).
+ */
+class TurboJpegCodec : public JpegCodec
+{
+public:
+    const char* name() const override { return "turbojpeg"; }
+    cv::Mat decode(const unsigned char* data, size_t size, int scale_denom = 1) const override;
+    bool encode(const cv::Mat& image, std::vector<unsigned char>& out, const JpegEncodeOptions& options = {}) const override;
+    using JpegCodec::decode;
+};
+#endif
+
+/**
+ * @brief Returns the process-wide codec for JPEG_BACKEND (OpenCV if TurboJPEG is not compiled in).
+ */
+const JpegCodec& jpegCodec();
+
+/**
+ * @brief Picks the largest DCT scale whose output still covers a target size
+ * @param Full image size
+ * @param Minimum long side after scaling (e.g. the detector input)
+ * @return Scale denominator: 1, 2, 4 or 8
+ */
+int jpegScaleForTarget(const cv::Size& full_size, int target_long_side);
+
+/**
+ * @brief Reads the image size from a JPEG header without decoding it
+ * @param Encoded bytes
+ * @param Number of bytes
+ * @return Image size, or an empty Size if no frame header is found
+ */
+cv::Size jpegImageSize(const unsigned char* data, size_t size);
+
+#endif  // JPEG_CODEC_H
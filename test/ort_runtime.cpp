@@ -0,0 +1,41 @@
+// Standard Library
+#include <mutex>
+#include <unordered_map>
+
+// Project headers
+#include "ort_runtime.h"
+#include "config.h"
+
+// === Static Shared ORT Environment with Global Thread Pool ===
+Ort::Env& OrtRuntime::getEnv() {
+    static Ort::Env env = [] {
+        Ort::ThreadingOptions threading_options;
+        threading_options.SetGlobalIntraOpNumThreads(ORT_INTRA_OP_THREADS);
+        threading_options.SetGlobalInterOpNumThreads(1);
+        threading_options.SetGlobalSpinControl(ORT_ALLOW_SPINNING ? 1 : 0);
+
+        return Ort::Env(threading_options, ORT_LOGGING_LEVEL_WARNING, "YoloEngine");
+    }();
+
+    return env;
+}
+
+// === Shared Session per Model Path (thread-safe) ===
+std::shared_ptr<Ort::Session> OrtRuntime::getSharedSession(const std::string& model_path) {
+    static std::mutex session_mutex;
+    static std::unordered_map<std::string, std::shared_ptr<Ort::Session>> session_map;
+
+    std::lock_guard<std::mutex> lock(session_mutex);
+
+    auto it = session_map.find(model_path);
+    if (it != session_map.end()) return it->second;
+
+    Ort::SessionOptions options;
+    options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+    options.DisablePerSessionThreads();
+
+    auto session = std::make_shared<Ort::Session>(getEnv(), model_path.c_str(), options);
+    session_map[model_path] = session;
+
+    return session;
+}
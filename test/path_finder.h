@@ -3,12 +3,15 @@
 
 // Standard Library
 #include <vector>
+#include <cstdint>
 
 // OpenCV
 #include <opencv2/core.hpp>
 
 // Project headers
 #include "congestion_analyzer.h"
+#include "grid.h"
+#include "quad_heap.h"
 
 /**
  * @brief Represents an exit point in the environment.
@@ -32,6 +35,13 @@ struct PathInfo {
 
 /**
  * @brief A* pathfinding class considering congestion data.
+ *
+ * The search state lives in flat per-cell arrays owned by the Pathfinder and
+ * reused across searches (a generation stamp marks what belongs to the
+ * current search), so repeated searches on the same map allocate nothing.
+ * calculatePaths() runs one A* per goal for a few goals, and from
+ * PATH_SWEEP_MIN_GOALS on a single Dijkstra sweep from the start, whose
+ * parent tree holds the path to each of them.
  */
 class Pathfinder {
 public:
@@ -45,10 +55,10 @@ public:
     ~Pathfinder() = default;
 
     /**
-     * @brief Sets the internal congestion map.
-     * @param 2D vector of congestion values.
+     * @brief Sets the congestion map the searches run on.
+     * @param View of the congestion grid; it is not copied and must outlive the searches.
      */
-    void setCongestionMap(const std::vector<std::vector<float>>& congestion_grid_map);
+    void setCongestionMap(GridView<const float> congestion_grid_map);
 
     /**
      * @brief Generates path information.
@@ -60,17 +70,73 @@ public:
      */
     PathInfo generatePathInfo(const cv::Point& incident_location_pixel, const Exit& exit, CongestionAnalyzer& analyzer, const int& exit_outer_crowd_counts);
 
+    /**
+     * @brief Generates the part of the path information that does not depend on outer crowd counts.
+     * @param Incident pixel location.
+     * @param Exit information.
+     * @param Congestion analyzer.
+     * @return Path, path cost and inner congestion; outer congestion and score are left unset.
+     */
+    PathInfo generatePathCandidate(const cv::Point& incident_location_pixel, const Exit& exit, CongestionAnalyzer& analyzer);
+
+    /**
+     * @brief Generates the count-independent path information for every exit with one search.
+     * @param Incident pixel location.
+     * @param Exits to route to.
+     * @param Congestion analyzer.
+     * @return One entry per exit, in the order of the exits, as generatePathCandidate() would return it.
+     */
+    std::vector<PathInfo> generatePathCandidates(const cv::Point& incident_location_pixel, const std::vector<Exit>& exits, CongestionAnalyzer& analyzer);
+
+    /**
+     * @brief Sets the outer congestion and score of a path from the outer crowd counts of its exit.
+     * @param Path information from generatePathCandidate().
+     * @param Outer crowd counts of exit.
+     */
+    void scorePathInfo(PathInfo& path_info, const int& exit_outer_crowd_counts);
+
     // === Utilities ===
     float calculateExitInnerCongestion(const cv::Point& exit_location, CongestionAnalyzer& analyzer);
     float calculateExitOuterCongestion(const int& exit_outer_crowd_counts);
     std::vector<cv::Point> calculatePath(const cv::Point& start_pixel, const cv::Point& goal_pixel);
+    std::vector<std::vector<cv::Point>> calculatePaths(const cv::Point& start_pixel, const std::vector<cv::Point>& goal_pixels);
+    std::vector<std::vector<cv::Point>> calculatePathsBySweep(const cv::Point& start_pixel, const std::vector<cv::Point>& goal_pixels);
     float calculatePathCost(const std::vector<cv::Point>& path);
     float calculateScore(const float& path_cost, const float& exit_inner_congestion, const float& exit_outer_congestion);
 
 private:
+    /**
+     * @brief Sizes the search arrays for the map and starts a new generation.
+     */
+    void prepareSearch();
+
+    /**
+     * @brief Searches from the start until every goal is closed or the map is exhausted.
+     * @param Start cell.
+     * @param Goal cells (at least one); A* with the octile distance for one goal, Dijkstra (no heuristic) for several.
+     * @return Number of distinct goals that were not reached.
+     */
+    size_t searchFrom(const cv::Point& grid_start, const std::vector<cv::Point>& grid_goals);
+
+    /**
+     * @brief Follows the parents of a closed cell back to the start.
+     * @return Path in pixel coordinates, start first.
+     */
+    std::vector<cv::Point> tracePath(int32_t goal_id) const;
+
+    int32_t cellId(const cv::Point& grid_cell) const;
+
     // === Members ===
     cv::Size image_size;
-    std::vector<std::vector<float>> congestion_grid_map;
+    GridView<const float> congestion_grid_map;
+
+    // === Search state, indexed by cell id (y * stride + x); padded by one closed cell ===
+    Grid<uint32_t> cell_state;      ///< 2 * generation: open, 2 * generation + 1: closed, older: unvisited
+    Grid<float> g_score;
+    Grid<int32_t> parent;
+    Grid<int32_t> heap_position;
+    QuadHeap open_heap;
+    uint32_t generation = 0;
 };
 
 #endif  // PATH_FINDER_H
\ No newline at end of file
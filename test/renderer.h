@@ -5,6 +5,8 @@
 #include "fall_info.h"
 #include "crowd_info.h"
 #include "path_finder.h"
+#include "jpeg_codec.h"
+#include "grid.h"
 
 /**
  * @brief Responsible for rendering visualization overlays onto frames.
@@ -18,9 +20,15 @@ public:
     void drawCrowdBoxes(cv::Mat& image, const std::vector<CrowdInfo>& crowd_info);
     void drawFall(cv::Mat& image, const std::vector<cv::Point>& people, int radius = 5);
     void drawCrowd(cv::Mat& image, const std::vector<cv::Point>& people, int radius = 5);
-    void drawCongestionHeatmap(cv::Mat& image, const std::vector<std::vector<float>>& congestion_grid_map);
+    void drawCongestionHeatmap(cv::Mat& image, GridView<const float> congestion_grid_map);
     void drawExits(cv::Mat& image, const std::vector<Exit>& exits);
     void drawPath(cv::Mat& image, const std::vector<cv::Point>& path, const cv::Point& start_pixel, const Exit& exit);
+
+    /**
+     * @brief Encodes a rendered frame as JPEG with the configured codec
+     * @return true if successful
+     */
+    bool encode(const cv::Mat& image, std::vector<unsigned char>& out, const JpegEncodeOptions& options = {}) const;
 };
 
 #endif  // RENDERER_H
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <limits>
 #include <iomanip>
 #include <chrono>
+#include <fstream>
 
 // Project Headers
 #include "fall_detector.h"
@@ -18,14 +19,26 @@ constexpr float COORD_TOLERANCE = 0.0f;
 constexpr float GRID_TOLERANCE = 0.0f;
 constexpr float PATH_TOLERANCE = 0.0f;
 
+// Tolerances for quantized (FP16 / INT8) models against FP32
+constexpr float QUANT_COORD_TOLERANCE = 8.0f;
+constexpr float QUANT_MIN_MATCH_RATIO = 0.9f;
+
+// Tolerance for batched inference against single-image inference
+constexpr float BATCH_COORD_TOLERANCE = 1.0f;
+
 // Configuration constants
 const int repeat_count = 10;
 
 // Helper comparison functions
 bool pointNear(const cv::Point& point_a, const cv::Point& point_b, float coord_tolerance = COORD_TOLERANCE);
 bool compareDetectFuzzy(const std::vector<cv::Point>& detect_a, const std::vector<cv::Point>& detect_b, float detect_tolerance = COORD_TOLERANCE);
-bool compareGridFuzzy(const std::vector<std::vector<float>>& grid_a, const std::vector<std::vector<float>>& grid_b, float grid_tolerance = GRID_TOLERANCE);
+bool compareGridFuzzy(const Grid<float>& grid_a, const Grid<float>& grid_b, float grid_tolerance = GRID_TOLERANCE);
 bool comparePathFuzzy(const std::vector<cv::Point>& path_a, const std::vector<cv::Point>& path_b, float path_tolerance = PATH_TOLERANCE);
+float matchDetectRatio(const std::vector<cv::Point>& reference, const std::vector<cv::Point>& candidate, float coord_tolerance = QUANT_COORD_TOLERANCE);
+std::vector<cv::Point> boxCenters(const std::vector<FallInfo>& fall_info);
+bool runQuantizationGate(const cv::Mat& fall_image, const cv::Mat& crowd_image, float fall_fp32_ms, float crowd_fp32_ms);
+bool runBatchCheck(FallDetector& fall_detector, CrowdDetector& crowd_detector, const cv::Mat& fall_image, const cv::Mat& crowd_image,
+	const std::vector<cv::Point>& reference_fall, const std::vector<cv::Point>& reference_crowd, float fall_single_ms, float crowd_single_ms);
 
 int main()
 {
@@ -75,7 +88,7 @@ int main()
 	// Reference values from the first run
 	std::vector<cv::Point> reference_fall_detect;
 	std::vector<cv::Point> reference_crowd_detect;
-	std::vector<std::vector<float>> reference_congestion_grid;
+	Grid<float> reference_congestion_grid;
 	std::vector<cv::Point> reference_path_finding;
 
 	// Initialize modules
@@ -84,6 +97,9 @@ int main()
 	CongestionAnalyzer analyzer(crowd_image.cols, crowd_image.rows);
 	Pathfinder pathfinder(crowd_image.cols, crowd_image.rows);
 
+	float total_fall_ms = 0.0f;
+	float total_crowd_ms = 0.0f;
+
 	for (int i = 0; i < repeat_count; ++i)
 	{
 		auto t0 = std::chrono::high_resolution_clock::now();
@@ -117,10 +133,11 @@ int main()
 		PathInfo result_path_finding = {};
 		result_path_finding.score = std::numeric_limits<float>::max();
 
-		for (size_t i = 0; i < exits.size(); ++i)
+		paths_info = pathfinder.generatePathCandidates(start_pixel, exits, analyzer);
+		for (size_t i = 0; i < paths_info.size(); ++i)
 		{
-			PathInfo path_info = pathfinder.generatePathInfo(start_pixel, exits.at(i), analyzer, exit_outer_crowd_counts.at(i));
-			paths_info.push_back(path_info);
+			PathInfo& path_info = paths_info.at(i);
+			pathfinder.scorePathInfo(path_info, exit_outer_crowd_counts.at(i));
 
 			if (result_path_finding.score > path_info.score) result_path_finding = path_info;
 		}
@@ -139,12 +156,15 @@ int main()
 		auto elapsed_congestion_grid = std::chrono::duration<float, std::milli>(t3 - t2).count();
 		auto elapsed_path_finding = std::chrono::duration<float, std::milli>(t4 - t3).count();
 
+		total_fall_ms += elapsed_fall_detect;
+		total_crowd_ms += elapsed_crowd_detect;
+
 		if (i == 0)
 		{
 			// Store baseline result for later comparisons
 			reference_fall_detect = result_fall_detect_centers;
 			reference_crowd_detect = result_crowd_detect_centers;
-			reference_congestion_grid = result_congestion_grid;
+			reference_congestion_grid = result_congestion_grid.clone();
 			reference_path_finding = result_path_finding.path;
 
 			std::cout << "[Run " << (i + 1) << "]" << std::endl;
@@ -182,9 +202,135 @@ int main()
 
 	std::cout << "All " << repeat_count << " runs produced consistent fall detection, crowd detection, congestion analysis, and path finding results." << std::endl;
 
+	if (!runBatchCheck(fall_detector, crowd_detector, fall_image, crowd_image,
+		reference_fall_detect, reference_crowd_detect, total_fall_ms / repeat_count, total_crowd_ms / repeat_count))
+	{
+		std::cerr << std::endl;
+		std::cerr << "[Error] Batched detection does not match single-image detection!" << std::endl;
+
+		return -1;
+	}
+
+	if (!runQuantizationGate(fall_image, crowd_image, total_fall_ms / repeat_count, total_crowd_ms / repeat_count))
+	{
+		std::cerr << std::endl;
+		std::cerr << "[Error] Quantized model accuracy gate failed!" << std::endl;
+
+		return -1;
+	}
+
 	return 0;
 }
 
+// Compare detectBatch() with detect() on a batch that spans more than one chunk
+bool runBatchCheck(FallDetector& fall_detector, CrowdDetector& crowd_detector, const cv::Mat& fall_image, const cv::Mat& crowd_image,
+	const std::vector<cv::Point>& reference_fall, const std::vector<cv::Point>& reference_crowd, float fall_single_ms, float crowd_single_ms)
+{
+	const size_t batch_size = YOLO_MAX_BATCH_SIZE + 1;
+	const std::vector<cv::Mat> fall_batch(batch_size, fall_image);
+	const std::vector<cv::Mat> crowd_batch(batch_size, crowd_image);
+
+	auto t0 = std::chrono::high_resolution_clock::now();
+	auto fall_results = fall_detector.detectBatch(fall_batch);
+	auto t1 = std::chrono::high_resolution_clock::now();
+	auto crowd_results = crowd_detector.detectBatch(crowd_batch);
+	auto t2 = std::chrono::high_resolution_clock::now();
+
+	float fall_per_image = std::chrono::duration<float, std::milli>(t1 - t0).count() / batch_size;
+	float crowd_per_image = std::chrono::duration<float, std::milli>(t2 - t1).count() / batch_size;
+
+	std::cout << std::endl << "[Batch " << batch_size << "] fall " << fall_per_image << " ms/image (single " << fall_single_ms << " ms), "
+		<< "crowd " << crowd_per_image << " ms/image (single " << crowd_single_ms << " ms)" << std::endl;
+
+	if (fall_results.size() != batch_size || crowd_results.size() != batch_size) return false;
+
+	for (size_t i = 0; i < batch_size; ++i)
+	{
+		if (!compareDetectFuzzy(reference_fall, fall_detector.getFallCenters(fall_results[i]), BATCH_COORD_TOLERANCE)) return false;
+		if (!compareDetectFuzzy(reference_crowd, crowd_detector.getCrowdCenters(crowd_results[i]), BATCH_COORD_TOLERANCE)) return false;
+	}
+
+	return true;
+}
+
+// Compare FP16 / INT8 model variants against FP32 detections and latency
+bool runQuantizationGate(const cv::Mat& fall_image, const cv::Mat& crowd_image, float fall_fp32_ms, float crowd_fp32_ms)
+{
+	FallDetector fall_fp32(FALL_MODEL_PATH, ModelPrecision::FP32);
+	CrowdDetector crowd_fp32(CROWD_MODEL_PATH, ModelPrecision::FP32);
+
+	const auto reference_fall = boxCenters(fall_fp32.detect(fall_image));
+	const auto reference_crowd = crowd_fp32.getCrowdCenters(crowd_fp32.detect(crowd_image));
+
+	bool passed = true;
+
+	std::cout << std::endl << "[Quantization gate] fp32: fall " << fall_fp32_ms << " ms, crowd " << crowd_fp32_ms << " ms" << std::endl;
+
+	for (ModelPrecision precision : { ModelPrecision::FP16, ModelPrecision::INT8 })
+	{
+		const std::string name = modelPrecisionName(precision);
+
+		const bool has_fall = std::ifstream(modelPathForPrecision(FALL_MODEL_PATH, precision)).good();
+		const bool has_crowd = std::ifstream(modelPathForPrecision(CROWD_MODEL_PATH, precision)).good();
+
+		if (has_fall)
+		{
+			FallDetector fall_detector(FALL_MODEL_PATH, precision);
+			if (fall_detector.precision() != precision)
+			{
+				std::cerr << "[" << name << "] Fall model could not be loaded" << std::endl;
+				passed = false;
+			}
+			else
+			{
+				std::vector<cv::Point> result;
+				auto t0 = std::chrono::high_resolution_clock::now();
+				for (int i = 0; i < repeat_count; ++i) result = boxCenters(fall_detector.detect(fall_image));
+				auto t1 = std::chrono::high_resolution_clock::now();
+
+				float ratio = matchDetectRatio(reference_fall, result);
+				float elapsed = std::chrono::duration<float, std::milli>(t1 - t0).count() / repeat_count;
+
+				std::cout << "[" << name << "] Fall detected: " << result.size() << " / " << reference_fall.size() << " (match " << ratio << ", " << elapsed << " ms)" << std::endl;
+				if (ratio < QUANT_MIN_MATCH_RATIO) passed = false;
+			}
+		}
+		else
+		{
+			std::cout << "[" << name << "] Fall model not found, skipped" << std::endl;
+		}
+
+		if (has_crowd)
+		{
+			CrowdDetector crowd_detector(CROWD_MODEL_PATH, precision);
+			if (crowd_detector.precision() != precision)
+			{
+				std::cerr << "[" << name << "] Crowd model could not be loaded" << std::endl;
+				passed = false;
+			}
+			else
+			{
+				std::vector<cv::Point> result;
+				auto t0 = std::chrono::high_resolution_clock::now();
+				for (int i = 0; i < repeat_count; ++i) result = crowd_detector.getCrowdCenters(crowd_detector.detect(crowd_image));
+				auto t1 = std::chrono::high_resolution_clock::now();
+
+				float ratio = matchDetectRatio(reference_crowd, result);
+				float elapsed = std::chrono::duration<float, std::milli>(t1 - t0).count() / repeat_count;
+
+				std::cout << "[" << name << "] Crowd detected: " << result.size() << " / " << reference_crowd.size() << " (match " << ratio << ", " << elapsed << " ms)" << std::endl;
+				if (ratio < QUANT_MIN_MATCH_RATIO) passed = false;
+			}
+		}
+		else
+		{
+			std::cout << "[" << name << "] Crowd model not found, skipped" << std::endl;
+		}
+	}
+
+	return passed;
+}
+
 // Euclidean distance-based point comparison
 bool pointNear(const cv::Point& point_a, const cv::Point& point_b, float coord_tolerance)
 {
@@ -220,16 +366,18 @@ bool compareDetectFuzzy(const std::vector<cv::Point>& detect_a, const std::vecto
 }
 
 // Compare two congestion grids with tolerance
-bool compareGridFuzzy(const std::vector<std::vector<float>>& grid_a, const std::vector<std::vector<float>>& grid_b, float grid_tolerance)
+bool compareGridFuzzy(const Grid<float>& grid_a, const Grid<float>& grid_b, float grid_tolerance)
 {
 	if (grid_a.size() != grid_b.size()) return false;
-	if (grid_a[0].size() != grid_b[0].size()) return false;
 
-	for (size_t y = 0; y < grid_a.size(); ++y)
+	for (int y = 0; y < grid_a.rows(); ++y)
 	{
-		for (size_t x = 0; x < grid_a[0].size(); ++x)
+		const float* row_a = grid_a.row(y);
+		const float* row_b = grid_b.row(y);
+
+		for (int x = 0; x < grid_a.cols(); ++x)
 		{
-			if (std::abs(grid_a[y][x] - grid_b[y][x]) > grid_tolerance) return false;
+			if (std::abs(row_a[x] - row_b[x]) > grid_tolerance) return false;
 		}
 	}
 
@@ -247,4 +395,42 @@ bool comparePathFuzzy(const std::vector<cv::Point>& path_a, const std::vector<cv
 	}
 
 	return true;
+}
+
+// Fraction of one-to-one matched points, relative to the larger set
+float matchDetectRatio(const std::vector<cv::Point>& reference, const std::vector<cv::Point>& candidate, float coord_tolerance)
+{
+	if (reference.empty() && candidate.empty()) return 1.0f;
+
+	std::vector<bool> matched(candidate.size(), false);
+	size_t match_count = 0;
+
+	for (const auto& p : reference)
+	{
+		for (size_t i = 0; i < candidate.size(); ++i)
+		{
+			if (!matched[i] && pointNear(p, candidate[i], coord_tolerance))
+			{
+				matched[i] = true;
+				++match_count;
+
+				break;
+			}
+		}
+	}
+
+	return static_cast<float>(match_count) / static_cast<float>(std::max(reference.size(), candidate.size()));
+}
+
+// Centers of all person boxes, fallen or not
+std::vector<cv::Point> boxCenters(const std::vector<FallInfo>& fall_info)
+{
+	std::vector<cv::Point> centers;
+
+	for (const auto& info : fall_info)
+	{
+		centers.push_back(info.bbox.tl() + cv::Point(info.bbox.width / 2, info.bbox.height / 2));
+	}
+
+	return centers;
 }
\ No newline at end of file
@@ -107,10 +107,11 @@ int main()
 		PathInfo best_path_info = {};
 		best_path_info.score = std::numeric_limits<float>::max();
 
-		for (size_t i = 0; i < exits.size(); ++i)
+		paths_info = pathfinder.generatePathCandidates(start_pixel, exits, analyzer);
+		for (size_t i = 0; i < paths_info.size(); ++i)
 		{
-			PathInfo path_info = pathfinder.generatePathInfo(start_pixel, exits.at(i), analyzer, exit_outer_crowd_counts.at(i));
-			paths_info.push_back(path_info);
+			PathInfo& path_info = paths_info.at(i);
+			pathfinder.scorePathInfo(path_info, exit_outer_crowd_counts.at(i));
 
 			if (best_path_info.score > path_info.score) best_path_info = path_info;
 		}
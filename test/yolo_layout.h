@@ -0,0 +1,173 @@
+#ifndef YOLO_LAYOUT_H
+#define YOLO_LAYOUT_H
+
+// Standard Library
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Project headers
+#include "config.h"
+#include "yolo_simd.h"
+
+/**
+ * @brief Single YOLO detection in original image coordinates.
+ */
+struct YoloDetection {
+    cv::Rect bbox;       ///< Bounding box in image coordinates
+    float conf = 0.0f;   ///< Detection confidence
+    int class_id = -1;   ///< Class ID
+};
+
+/**
+ * @brief Detection candidates decoded from one output tensor, before NMS.
+ */
+struct YoloCandidates {
+    std::vector<cv::Rect> boxes;
+    std::vector<float> scores;
+    std::vector<int> class_ids;
+
+    // Decode scratch, overwritten on each call and kept for its capacity
+    std::vector<float> max_scores;
+    std::vector<uint32_t> indices;
+
+    void clear() {
+        boxes.clear();
+        scores.clear();
+        class_ids.clear();
+    }
+};
+
+/**
+ * @brief Letterbox parameters of one image in a (batched) input tensor.
+ */
+struct YoloLetterbox {
+    float scale = 1.0f;  ///< Resize factor applied to the image
+    int top = 0;         ///< Top padding in pixels
+    int left = 0;        ///< Left padding in pixels
+};
+
+/**
+ * @brief Maps a box from letterboxed model space back to the original image.
+ * @param Box in model input coordinates
+ * @param Scale factor used
+ * @param Top padding in pixels
+ * @param Left padding in pixels
+ * @return Box in original image coordinates
+ */
+inline cv::Rect unletterboxRect(const cv::Rect& box, float scale, int top, int left) {
+    return cv::Rect(static_cast<int>(std::round((box.x - left) / scale)),
+        static_cast<int>(std::round((box.y - top) / scale)),
+        static_cast<int>(std::round(box.width / scale)),
+        static_cast<int>(std::round(box.height / scale)));
+}
+
+/**
+ * @brief YOLOv8 output: [1, 4 + num_classes, num_boxes], channels-major.
+ *
+ * Each class row is contiguous, so the per-box maximum and the threshold test
+ * run as vector operations over whole rows before any box is built.
+ */
+struct YoloV8Layout {
+    /**
+     * @brief Decodes boxes whose best class score exceeds the threshold
+     * @param Output tensor data
+     * @param Output tensor shape
+     * @param Confidence threshold
+     * @param Class to keep (-1 keeps all classes)
+     * @param Scale factor used
+     * @param Top padding in pixels
+     * @param Left padding in pixels
+     * @param Decoded candidates (appended)
+     */
+    static void decode(const float* data, const std::vector<int64_t>& shape, float conf_threshold, int class_filter,
+        float scale, int top, int left, YoloCandidates& out) {
+        if (shape.size() < 3 || shape[1] < 5) return;
+
+        const size_t num_classes = static_cast<size_t>(shape[1] - 4);
+        const size_t num_boxes = static_cast<size_t>(shape[2]);
+        const float* class_rows = data + 4 * num_boxes;
+
+        // Best score per box, one contiguous class row at a time (single-class models use the row as is)
+        const float* best = class_rows;
+        if (num_classes > 1) {
+            out.max_scores.assign(class_rows, class_rows + num_boxes);
+            for (size_t c = 1; c < num_classes; ++c) {
+                simdMaxInPlace(out.max_scores.data(), class_rows + c * num_boxes, num_boxes);
+            }
+            best = out.max_scores.data();
+        }
+
+        out.indices.resize(num_boxes);
+        const size_t survivors = simdSelectAbove(best, num_boxes, conf_threshold, out.indices.data());
+
+        // Only boxes above the threshold are materialized
+        for (size_t k = 0; k < survivors; ++k) {
+            const size_t i = out.indices[k];
+
+            float max_conf = 0.0f;
+            int cls = -1;
+
+            for (size_t c = 0; c < num_classes; ++c) {
+                const float score = class_rows[i + c * num_boxes];
+                if (score > max_conf) {
+                    max_conf = score;
+                    cls = static_cast<int>(c);
+                }
+            }
+
+            if (class_filter >= 0 && cls != class_filter) continue;
+
+            const cv::Rect box = convertXywhToXyxy(data[i], data[i + num_boxes], data[i + 2 * num_boxes], data[i + 3 * num_boxes]);
+
+            out.boxes.push_back(unletterboxRect(box, scale, top, left));
+            out.scores.push_back(max_conf);
+            out.class_ids.push_back(cls);
+        }
+    }
+};
+
+/**
+ * @brief YOLOv5-style output: [1, num_boxes, 6] rows of (x, y, w, h, conf, class).
+ *
+ * Rows interleave all fields, so the confidence test stays a strided scalar scan.
+ */
+struct YoloV5Layout {
+    /**
+     * @brief Decodes rows whose confidence reaches the threshold
+     * @param Output tensor data
+     * @param Output tensor shape
+     * @param Confidence threshold
+     * @param Class to keep (-1 keeps all classes)
+     * @param Scale factor used
+     * @param Top padding in pixels
+     * @param Left padding in pixels
+     * @param Decoded candidates (appended)
+     */
+    static void decode(const float* data, const std::vector<int64_t>& shape, float conf_threshold, int class_filter,
+        float scale, int top, int left, YoloCandidates& out) {
+        if (shape.size() < 2) return;
+
+        const size_t num_boxes = static_cast<size_t>(shape[1]);
+        const size_t stride = shape.size() >= 3 ? static_cast<size_t>(shape[2]) : 6;
+        if (stride < 5) return;
+
+        for (size_t i = 0; i < num_boxes; ++i) {
+            const float* row = data + i * stride;
+
+            const float conf = row[4];
+            if (conf < conf_threshold) continue;
+
+            const int cls = stride > 5 ? static_cast<int>(row[5]) : 0;
+            if (class_filter >= 0 && cls != class_filter) continue;
+
+            const cv::Rect box = convertXywhToXyxy(row[0], row[1], row[2], row[3]);
+
+            out.boxes.push_back(unletterboxRect(box, scale, top, left));
+            out.scores.push_back(conf);
+            out.class_ids.push_back(cls);
+        }
+    }
+};
+
+#endif  // YOLO_LAYOUT_H
@@ -0,0 +1,93 @@
+// Standard Library
+#include <algorithm>
+
+// Project headers
+#include "yolo_nms.h"
+
+// === Greedy NMS over Score-Sorted Boxes ===
+const std::vector<int>& YoloNms::run(const std::vector<cv::Rect>& boxes, const std::vector<float>& scores, float threshold,
+    OverlapMetric metric) {
+    const size_t n = scores.size();
+
+    keep.clear();
+    sortByScore(scores);
+
+    x1.resize(n);
+    y1.resize(n);
+    x2.resize(n);
+    y2.resize(n);
+    area.resize(n);
+    suppressed.assign(n, 0);
+
+    for (size_t i = 0; i < n; ++i) {
+        const cv::Rect& box = boxes[order[i].second];
+        x1[i] = static_cast<float>(box.x);
+        y1[i] = static_cast<float>(box.y);
+        x2[i] = static_cast<float>(box.x + box.width);
+        y2[i] = static_cast<float>(box.y + box.height);
+        area[i] = static_cast<float>(box.area());
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        if (suppressed[i]) continue;
+
+        keep.push_back(order[i].second);
+        simdSuppressOverlaps(x1.data(), y1.data(), x2.data(), y2.data(), area.data(), i + 1, n, i, threshold, metric, suppressed.data());
+    }
+
+    return keep;
+}
+
+// === Class-aware Merge across Views ===
+const std::vector<int>& YoloNms::runViewMerge(const std::vector<cv::Rect>& boxes, const std::vector<float>& scores, const std::vector<int>& class_ids,
+    const std::vector<int>& views, const std::vector<uint8_t>& on_seam, float iou_threshold, float ios_threshold) {
+    const size_t n = scores.size();
+
+    keep.clear();
+    sortByScore(scores);
+    suppressed.assign(n, 0);
+
+    // A few hundred boxes at most after per-view NMS, so the pairwise scan stays scalar
+    for (size_t i = 0; i < n; ++i) {
+        if (suppressed[i]) continue;
+
+        const int a = order[i].second;
+        keep.push_back(a);
+
+        for (size_t j = i + 1; j < n; ++j) {
+            const int b = order[j].second;
+            if (suppressed[j] || views[a] == views[b] || class_ids[a] != class_ids[b]) continue;
+
+            const float inter = static_cast<float>((boxes[a] & boxes[b]).area());
+            if (inter <= 0.0f) continue;
+
+            const float area_a = static_cast<float>(boxes[a].area());
+            const float area_b = static_cast<float>(boxes[b].area());
+
+            if (on_seam[a] || on_seam[b]) {
+                if (inter / (std::min(area_a, area_b) + 1e-6f) > ios_threshold) suppressed[j] = 1;
+            }
+            else {
+                if (inter / (area_a + area_b - inter + 1e-6f) > iou_threshold) suppressed[j] = 1;
+            }
+        }
+    }
+
+    return keep;
+}
+
+// === Score Order ===
+void YoloNms::sortByScore(const std::vector<float>& scores) {
+    const size_t n = scores.size();
+
+    order.clear();
+    order.reserve(n);
+
+    for (size_t i = 0; i < n; ++i) {
+        order.emplace_back(scores[i], static_cast<int>(i));
+    }
+
+    std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+        });
+}
@@ -0,0 +1,141 @@
+// Standard Library
+#include <algorithm>
+#include <stdexcept>
+
+// OpenCV
+#include <opencv2/imgproc.hpp>
+
+// SIMD
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define YOLO_PREPROCESS_NEON 1
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#define YOLO_PREPROCESS_SSSE3 1
+#endif
+
+// Project headers
+#include "yolo_preprocessor.h"
+
+namespace {
+constexpr float kInv255 = 1.0f / 255.0f;
+constexpr float kPadValue = 114.0f / 255.0f;
+}
+
+// === Constructor ===
+YoloPreprocessor::YoloPreprocessor(int input_width, int input_height)
+    : input_size(input_width, input_height) {
+}
+
+// === Tensor Element Count ===
+size_t YoloPreprocessor::tensorSize() const {
+    return static_cast<size_t>(3) * input_size.width * input_size.height;
+}
+
+// === Fused Letterbox + BGR2RGB + Normalize + HWC2CHW ===
+void YoloPreprocessor::run(const cv::Mat& image, float* tensor_data, float& scale, int& top, int& left) {
+    if (image.empty()) throw std::runtime_error("Input image is empty.");
+    if (image.type() != CV_8UC3) throw std::runtime_error("Input image must be CV_8UC3.");
+    if (!tensor_data) throw std::runtime_error("Tensor buffer is null.");
+
+    const int dst_w = input_size.width;
+    const int dst_h = input_size.height;
+
+    scale = std::min(static_cast<float>(dst_w) / image.cols, static_cast<float>(dst_h) / image.rows);
+
+    const int new_w = std::min(dst_w, static_cast<int>(image.cols * scale));
+    const int new_h = std::min(dst_h, static_cast<int>(image.rows * scale));
+
+    left = (dst_w - new_w) / 2;
+    top = (dst_h - new_h) / 2;
+
+    // Only the resize goes through OpenCV; the destination is reused between calls
+    const cv::Mat* src = &image;
+    if (new_w != image.cols || new_h != image.rows) {
+        cv::resize(image, resized, cv::Size(new_w, new_h));
+        src = &resized;
+    }
+
+    const size_t plane = static_cast<size_t>(dst_w) * dst_h;
+    float* plane_r = tensor_data;
+    float* plane_g = tensor_data + plane;
+    float* plane_b = tensor_data + 2 * plane;
+
+    const int right = dst_w - left - new_w;
+
+    for (int y = 0; y < dst_h; ++y) {
+        const size_t row = static_cast<size_t>(y) * dst_w;
+        float* r = plane_r + row;
+        float* g = plane_g + row;
+        float* b = plane_b + row;
+
+        const int sy = y - top;
+        if (sy < 0 || sy >= new_h) {
+            fillPlaneRow(r, dst_w, kPadValue);
+            fillPlaneRow(g, dst_w, kPadValue);
+            fillPlaneRow(b, dst_w, kPadValue);
+            continue;
+        }
+
+        fillPlaneRow(r, left, kPadValue);
+        fillPlaneRow(g, left, kPadValue);
+        fillPlaneRow(b, left, kPadValue);
+
+        convertRow(src->ptr<uchar>(sy), r + left, g + left, b + left, new_w);
+
+        fillPlaneRow(r + left + new_w, right, kPadValue);
+        fillPlaneRow(g + left + new_w, right, kPadValue);
+        fillPlaneRow(b + left + new_w, right, kPadValue);
+    }
+}
+
+// === Fill Padding Span ===
+void YoloPreprocessor::fillPlaneRow(float* dst, int count, float value) {
+    if (count > 0) std::fill(dst, dst + count, value);
+}
+
+// === Convert One BGR Row into R/G/B Planes ===
+void YoloPreprocessor::convertRow(const uchar* src, float* dst_r, float* dst_g, float* dst_b, int count) {
+    int x = 0;
+
+#if defined(YOLO_PREPROCESS_NEON)
+    const float32x4_t k = vdupq_n_f32(kInv255);
+
+    auto store_u8x16 = [&k](float* dst, uint8x16_t v) {
+        const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+        const uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+        vst1q_f32(dst + 0, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))), k));
+        vst1q_f32(dst + 4, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo))), k));
+        vst1q_f32(dst + 8, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))), k));
+        vst1q_f32(dst + 12, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi))), k));
+    };
+
+    // vld3q_u8 de-interleaves 16 BGR pixels into separate B, G and R registers
+    for (; x + 16 <= count; x += 16) {
+        const uint8x16x3_t bgr = vld3q_u8(src + 3 * x);
+        store_u8x16(dst_b + x, bgr.val[0]);
+        store_u8x16(dst_g + x, bgr.val[1]);
+        store_u8x16(dst_r + x, bgr.val[2]);
+    }
+#elif defined(YOLO_PREPROCESS_SSSE3)
+    const __m128 k = _mm_set1_ps(kInv255);
+    const __m128i shuffle_b = _mm_setr_epi8(0, -1, -1, -1, 3, -1, -1, -1, 6, -1, -1, -1, 9, -1, -1, -1);
+    const __m128i shuffle_g = _mm_setr_epi8(1, -1, -1, -1, 4, -1, -1, -1, 7, -1, -1, -1, 10, -1, -1, -1);
+    const __m128i shuffle_r = _mm_setr_epi8(2, -1, -1, -1, 5, -1, -1, -1, 8, -1, -1, -1, 11, -1, -1, -1);
+
+    // Each 16-byte load covers 4 pixels (12 bytes); stop early so the load never runs past the row
+    for (; x + 6 <= count; x += 4) {
+        const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 3 * x));
+        _mm_storeu_ps(dst_b + x, _mm_mul_ps(_mm_cvtepi32_ps(_mm_shuffle_epi8(px, shuffle_b)), k));
+        _mm_storeu_ps(dst_g + x, _mm_mul_ps(_mm_cvtepi32_ps(_mm_shuffle_epi8(px, shuffle_g)), k));
+        _mm_storeu_ps(dst_r + x, _mm_mul_ps(_mm_cvtepi32_ps(_mm_shuffle_epi8(px, shuffle_r)), k));
+    }
+#endif
+
+    for (; x < count; ++x) {
+        const uchar* p = src + 3 * x;
+        dst_b[x] = p[0] * kInv255;
+        dst_g[x] = p[1] * kInv255;
+        dst_r[x] = p[2] * kInv255;
+    }
+}
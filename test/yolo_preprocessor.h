@@ -0,0 +1,51 @@
+#ifndef YOLO_PREPROCESSOR_H
+#define YOLO_PREPROCESSOR_H
+
+// OpenCV
+#include <opencv2/core.hpp>
+
+/**
+ * @brief Converts BGR frames into normalized RGB CHW tensors for YOLO models.
+ *
+ * Letterbox padding, channel swap, normalization and HWC->CHW reordering are
+ * fused into a single pass that writes directly into caller-owned tensor memory.
+ * Scratch buffers are kept between calls, so steady-state use does not allocate.
+ */
+class YoloPreprocessor {
+public:
+    /**
+     * @brief Constructs a preprocessor for a fixed model input size.
+     * @param Model input width
+     * @param Model input height
+     */
+    YoloPreprocessor(int input_width, int input_height);
+
+    ~YoloPreprocessor() = default;
+
+    /**
+     * @brief Letterboxes the image and writes a 3 x H x W float tensor.
+     * @param Input BGR image (CV_8UC3)
+     * @param Destination tensor memory (at least 3 * H * W floats)
+     * @param Scale factor used
+     * @param Top padding in pixels
+     * @param Left padding in pixels
+     */
+    void run(const cv::Mat& image, float* tensor_data, float& scale, int& top, int& left);
+
+    /**
+     * @brief Number of floats written by run().
+     * @return Tensor element count
+     */
+    size_t tensorSize() const;
+
+private:
+    // === Kernels ===
+    static void fillPlaneRow(float* dst, int count, float value);
+    static void convertRow(const uchar* src, float* dst_r, float* dst_g, float* dst_b, int count);
+
+    // === Members ===
+    cv::Size input_size;
+    cv::Mat resized;
+};
+
+#endif  // YOLO_PREPROCESSOR_H